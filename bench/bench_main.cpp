@@ -0,0 +1,577 @@
+#include "bench_scenarios.h"
+
+#include "cursesdef.h"
+#include "debug.h"
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
+#include "inventory.h"
+#include "json.h"
+#include "line.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "map_iterator.h"
+#include "map_selector.h"
+#include "monster.h"
+#include "mtype.h"
+#include "npc.h"
+#include "options.h"
+#include "output.h"
+#include "path_info.h"
+#include "player.h"
+#include "rng.h"
+#include "save_writer.h"
+#include "submap.h"
+#include "turn_profiler.h"
+#include "vehicle.h"
+#include "veh_type.h"
+#include "worldfactory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+/*
+ * Headless world simulation benchmark.
+ *
+ * Creates a throwaway world with a fixed seed, then for each scenario builds the scripted
+ * situation and runs a number of game turns without any UI. The results (turns per second
+ * and the per phase breakdown of the turn profiler) are written as JSON, so they can be
+ * compared between builds. Some parts of the engine are also measured on their own, see
+ * the item and submap benchmarks.
+ */
+
+/** Argument value if @p arg is of the form "<prefix>value", else nullptr. */
+static const char *option_value( const char *arg, const char *prefix )
+{
+    return strncmp( arg, prefix, strlen( prefix ) ) == 0 ? arg + strlen( prefix ) : nullptr;
+}
+
+static std::vector<std::string> split( const std::string &str, const char delim )
+{
+    std::vector<std::string> ret;
+    size_t start = 0;
+    while( start <= str.size() ) {
+        const size_t end = std::min( str.find( delim, start ), str.size() );
+        if( end > start ) {
+            ret.push_back( str.substr( start, end - start ) );
+        }
+        start = end + 1;
+    }
+    return ret;
+}
+
+static void init_global_game_state( const std::vector<std::string> &mods )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( "./" );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( FILENAMES["config_dir"] ) || !assure_dir_exist( FILENAMES["savedir"] ) ) {
+        throw std::runtime_error( "Unable to make config or save directory. Check permissions." );
+    }
+
+    get_options().init();
+    get_options().load();
+    // The benchmark measures the simulation, not saving.
+    get_options().get_option( "AUTOSAVE" ).setValue( "false" );
+    init_colors();
+
+    g = new game;
+    g->load_static_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->get_all_worlds();
+    WORLDPTR bench_world = world_generator->make_new_world( mods );
+    if( bench_world == nullptr ) {
+        throw std::runtime_error( "Unable to create the benchmark world." );
+    }
+    world_generator->set_active_world( bench_world );
+
+    g->load_core_data();
+    g->load_world_modfiles( world_generator->active_world );
+
+    g->u = player();
+    g->u.create( PLTYPE_NOW );
+    // The player only watches, monsters must not end the benchmark early.
+    g->u.set_mutation( trait_id( "DEBUG_NODMG" ) );
+
+    g->m = map( get_option<bool>( "ZLEVELS" ) );
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+}
+
+static double seconds_since( const std::chrono::steady_clock::time_point &start )
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+static void run_scenario( const bench_scenario &sc, const int turns, JsonOut &jsout )
+{
+    std::cerr << "Running " << sc.name << " (" << turns << " turns)" << std::endl;
+    sc.setup();
+
+    turn_profiler::reset();
+    turn_profiler::set_enabled( true );
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < turns; turn++ ) {
+        if( sc.per_turn ) {
+            turn_profiler::scoped_phase phase( "scenario" );
+            sc.per_turn( turn );
+        }
+        if( g->do_turn() ) {
+            std::cerr << "The game ended during " << sc.name << std::endl;
+            break;
+        }
+    }
+    const double seconds = seconds_since( start );
+    turn_profiler::set_enabled( false );
+
+    const unsigned long done = turn_profiler::turns();
+    jsout.start_object();
+    jsout.member( "name", sc.name );
+    jsout.member( "turns", done );
+    jsout.member( "seconds", seconds );
+    jsout.member( "turns_per_second", seconds > 0 ? done / seconds : 0.0 );
+    jsout.member( "monsters", g->num_zombies() );
+    jsout.member( "phases" );
+    jsout.start_array();
+    for( const auto &stats : turn_profiler::phases() ) {
+        jsout.start_object();
+        jsout.member( "phase", stats.path() );
+        jsout.member( "count", stats.count );
+        jsout.member( "total_ms", stats.total_ms );
+        jsout.member( "ms_per_turn", done > 0 ? stats.total_ms / done : 0.0 );
+        jsout.member( "max_ms", stats.max_ms );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+/**
+ * Measures the submap storage: the size of a submap, how long it takes to create one and
+ * how long it takes to generate and to load (from the save) an area of the world.
+ */
+static void run_submap_benchmark( JsonOut &jsout )
+{
+    static const int constructed = 1000;
+    // Overmap terrain tiles (2x2 submaps each) generated and loaded, in a square.
+    static const int area_size = 4;
+    std::cerr << "Running submap benchmark" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::unique_ptr<submap>> submaps;
+        for( int i = 0; i < constructed; i++ ) {
+            submaps.emplace_back( new submap() );
+        }
+    }
+    const double construct_seconds = seconds_since( start );
+
+    // Far enough away from the reality bubble to not be kept in memory when saving.
+    const tripoint origin( g->m.get_abs_sub().x + MAPSIZE * 4, g->m.get_abs_sub().y, 0 );
+    const auto load_area = [&origin]() {
+        tinymap tm;
+        for( int y = 0; y < area_size; y++ ) {
+            for( int x = 0; x < area_size; x++ ) {
+                tm.load( origin.x + x * 2, origin.y + y * 2, origin.z, false );
+            }
+        }
+    };
+
+    start = std::chrono::steady_clock::now();
+    load_area();
+    const double generate_seconds = seconds_since( start );
+
+    const int num_submaps = area_size * area_size * 4;
+    size_t sparse_entries = 0;
+    for( int y = 0; y < area_size * 2; y++ ) {
+        for( int x = 0; x < area_size * 2; x++ ) {
+            const submap *sm = MAPBUFFER.lookup_submap( origin.x + x, origin.y + y, origin.z );
+            if( sm != nullptr ) {
+                sparse_entries += sm->itm.size() + sm->fld.size() + sm->rad.size() + sm->cosmetics.size();
+            }
+        }
+    }
+
+    // Saving drops the generated submaps from memory, so loading them again reads the save.
+    MAPBUFFER.save();
+    save_writer::wait();
+    start = std::chrono::steady_clock::now();
+    load_area();
+    const double load_seconds = seconds_since( start );
+
+    int buffered = 0;
+    int shared = 0;
+    for( const auto &elem : MAPBUFFER ) {
+        buffered++;
+        shared += elem.second->is_shared ? 1 : 0;
+    }
+
+    jsout.start_object();
+    jsout.member( "submap_bytes", static_cast<int>( sizeof( submap ) ) );
+    jsout.member( "buffered_locations", buffered );
+    jsout.member( "shared_locations", shared );
+    jsout.member( "sparse_entries_per_submap", static_cast<double>( sparse_entries ) / num_submaps );
+    jsout.member( "construct_destroy_us", construct_seconds * 1e6 / constructed );
+    jsout.member( "generate_ms_per_submap", generate_seconds * 1e3 / num_submaps );
+    jsout.member( "load_ms_per_submap", load_seconds * 1e3 / num_submaps );
+    jsout.end_object();
+}
+
+/**
+ * Measures walking and collecting items: a looted warehouse around the player, whose items
+ * are visited on the map and collected into an inventory by form_from_map, as the crafting
+ * inventory is.
+ */
+static void run_item_benchmark( JsonOut &jsout )
+{
+    static const int repeats = 20;
+    static const std::vector<std::string> shelves = {{
+            "hardware", "tools_common", "electronics", "office", "allclothes", "cannedfood", "snacks",
+            "mischw"
+        }
+    };
+    std::cerr << "Running item benchmark" << std::endl;
+
+    clear_bubble( "t_floor" );
+    const tripoint center = g->u.pos();
+    size_t shelf = 0;
+    for( const tripoint &p : g->m.points_in_radius( center, PICKUP_RANGE ) ) {
+        // Whatever is left of a few shelves on every tile.
+        for( int i = 0; i < 3; i++ ) {
+            g->m.put_items_from_loc( shelves[shelf++ % shelves.size()], p, calendar::turn );
+        }
+    }
+
+    const auto count_items = []( const visitable<map_selector> &v ) {
+        int res = 0;
+        v.visit_items( [&res]( const item * ) {
+            res++;
+            return VisitResponse::NEXT;
+        } );
+        return res;
+    };
+
+    const map_selector warehouse( center, PICKUP_RANGE );
+    int items = 0;
+    auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < repeats; i++ ) {
+        items = count_items( warehouse );
+    }
+    const double visit_map_seconds = seconds_since( start );
+
+    inventory inv;
+    start = std::chrono::steady_clock::now();
+    for( int i = 0; i < repeats; i++ ) {
+        inv.form_from_map( center, PICKUP_RANGE, false );
+    }
+    const double form_seconds = seconds_since( start );
+
+    int inv_items = 0;
+    start = std::chrono::steady_clock::now();
+    for( int i = 0; i < repeats; i++ ) {
+        inv_items = 0;
+        inv.visit_items( [&inv_items]( const item * ) {
+            inv_items++;
+            return VisitResponse::NEXT;
+        } );
+    }
+    const double visit_inventory_seconds = seconds_since( start );
+
+    jsout.start_object();
+    jsout.member( "items", items );
+    jsout.member( "inventory_items", inv_items );
+    jsout.member( "inventory_stacks", static_cast<int>( inv.size() ) );
+    jsout.member( "visit_map_ms", visit_map_seconds * 1e3 / repeats );
+    jsout.member( "form_from_map_ms", form_seconds * 1e3 / repeats );
+    jsout.member( "visit_inventory_ms", visit_inventory_seconds * 1e3 / repeats );
+    jsout.end_object();
+}
+
+/**
+ * Measures looking up the creature on a tile, which is done for every tile of a ray or of
+ * the screen: a crowd of monsters and NPCs around the player, drawn to an invisible
+ * full-screen terrain window and shot at by burst fire in all directions.
+ */
+static void run_lookup_benchmark( JsonOut &jsout )
+{
+    static const int monsters = 400;
+    static const int npcs = 40;
+    static const int draws = 20;
+    static const int bursts = 20;
+    static const int rays = 360;
+    static const int range = 60;
+    std::cerr << "Running lookup benchmark" << std::endl;
+
+    clear_bubble( "t_dirt" );
+    const tripoint center = g->u.pos();
+    const mtype_id mon_zombie( "mon_zombie" );
+    for( int i = 0; i < monsters + npcs; i++ ) {
+        // A spiral, so the crowd is dense near the player and thins out.
+        const double angle = i * 2.4;
+        const double radius = 2 + sqrt( i ) * 2;
+        const tripoint p = center + tripoint( int( radius * cos( angle ) ), int( radius * sin( angle ) ), 0 );
+        if( i % ( ( monsters + npcs ) / npcs ) == 0 ) {
+            npc *who = new npc();
+            who->normalize();
+            who->randomize();
+            who->spawn_at_precise( { g->get_levx(), g->get_levy() }, p );
+        } else {
+            g->summon_mon( mon_zombie, p );
+        }
+    }
+    g->load_npcs();
+
+    jsout.start_object();
+    jsout.member( "monsters", g->num_zombies() );
+    jsout.member( "npcs", static_cast<int>( g->active_npc.size() ) );
+
+#ifndef TILES
+    // Curses writing to nowhere, so the draw runs like in the game but shows nothing.
+    FILE *out = fopen( "/dev/null", "w" );
+    FILE *in = fopen( "/dev/null", "r" );
+    SCREEN *screen = out != nullptr && in != nullptr ? newterm( nullptr, out, in ) : nullptr;
+    if( screen != nullptr ) {
+        // The terrain window of a large terminal.
+        resizeterm( 61, 181 );
+        TERRAIN_WINDOW_WIDTH = COLS;
+        TERRAIN_WINDOW_HEIGHT = LINES;
+        POSX = TERRAIN_WINDOW_WIDTH / 2;
+        POSY = TERRAIN_WINDOW_HEIGHT / 2;
+        g->w_terrain = newwin( TERRAIN_WINDOW_HEIGHT, TERRAIN_WINDOW_WIDTH, 0, 0 );
+        const auto start = std::chrono::steady_clock::now();
+        for( int i = 0; i < draws; i++ ) {
+            g->draw_ter();
+        }
+        const double draw_seconds = seconds_since( start );
+        delwin( g->w_terrain );
+        g->w_terrain = nullptr;
+        endwin();
+        delscreen( screen );
+        jsout.member( "screen_tiles", TERRAIN_WINDOW_WIDTH * TERRAIN_WINDOW_HEIGHT );
+        jsout.member( "draw_ms", draw_seconds * 1e3 / draws );
+    }
+    if( out != nullptr ) {
+        fclose( out );
+    }
+    if( in != nullptr ) {
+        fclose( in );
+    }
+#endif
+
+    // Every tile of every ray is checked, a bullet would stop at the first hit.
+    int tiles = 0;
+    int hits = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for( int burst = 0; burst < bursts; burst++ ) {
+        for( int ray = 0; ray < rays; ray++ ) {
+            const double angle = 2 * M_PI * ray / rays;
+            const tripoint target = center + tripoint( int( range * cos( angle ) ), int( range * sin( angle ) ), 0 );
+            for( const tripoint &p : line_to( center, target ) ) {
+                tiles++;
+                hits += g->critter_at( p ) != nullptr ? 1 : 0;
+            }
+        }
+    }
+    const double sweep_seconds = seconds_since( start );
+
+    jsout.member( "sweep_tiles", tiles / bursts );
+    jsout.member( "sweep_hits", hits / bursts );
+    jsout.member( "sweep_ms", sweep_seconds * 1e3 / bursts );
+    jsout.member( "lookup_ns", tiles > 0 ? sweep_seconds * 1e9 / tiles : 0.0 );
+    jsout.end_object();
+
+    clear_bubble( "t_dirt" );
+}
+
+/**
+ * Measures explosions: large blasts, some of them fiery, going off in a walled area full
+ * of monsters, items and cars. The digest sums up what the blasts left behind, the same
+ * seed must give the same digest unless the blasts are meant to work differently.
+ */
+static void run_explosion_benchmark( JsonOut &jsout )
+{
+    static const int blasts = 12;
+    static const int monsters = 300;
+    std::cerr << "Running explosion benchmark" << std::endl;
+
+    clear_bubble( "t_pavement" );
+    const tripoint center = g->u.pos();
+    const int bubble_size = MAPSIZE * SEEX;
+    const tripoint top_left( 0, 0, 0 );
+    const tripoint bottom_right( bubble_size - 1, bubble_size - 1, 0 );
+    const ter_id wall( "t_brick_wall" );
+    const ter_id window( "t_window" );
+    for( const tripoint &p : g->m.points_in_rectangle( top_left, bottom_right ) ) {
+        // The player stays out of the blasts, in the middle of an open square.
+        if( rl_dist( p, center ) < 12 ) {
+            continue;
+        }
+        if( p.x % 9 == 0 || p.y % 9 == 0 ) {
+            g->m.ter_set( p, ( p.x + p.y ) % 7 == 0 ? window : wall );
+        } else if( ( p.x * 7 + p.y * 3 ) % 11 == 0 ) {
+            g->m.put_items_from_loc( "kitchen", p, calendar::turn );
+        }
+    }
+    const mtype_id mon_zombie( "mon_zombie" );
+    for( int i = 0; i < monsters; i++ ) {
+        // One or two in each of the rooms between the walls.
+        g->summon_mon( mon_zombie, tripoint( 9 * ( i % 14 ) + 2 + 4 * ( i / 196 ), 9 * ( i / 14 % 14 ) + 4, 0 ) );
+    }
+    for( int i = 0; i < 4; i++ ) {
+        g->m.add_vehicle( vproto_id( "car" ), tripoint( 20 + i * 30, 25 + ( i % 2 ) * 80, 0 ), 0, 100, 0 );
+    }
+    g->m.build_map_cache( 0, true );
+
+    const auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < blasts; i++ ) {
+        // On a circle around the player, out of reach of the blasts.
+        const double angle = 2 * M_PI * i / blasts;
+        const tripoint p = center + tripoint( int( 45 * cos( angle ) ), int( 45 * sin( angle ) ), 0 );
+        g->explosion( p, 100 + 40 * ( i % 4 ), 0.8f, i % 3 == 0, 0, 0 );
+    }
+    const double seconds = seconds_since( start );
+
+    unsigned long digest = 0;
+    const auto add = [&digest]( const long value ) {
+        digest = digest * 31 + value;
+    };
+    int survivors = 0;
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        const monster &critter = g->zombie( i );
+        survivors += critter.is_dead() ? 0 : 1;
+        add( critter.posx() + critter.posy() * bubble_size );
+        add( critter.get_hp() );
+    }
+    for( const tripoint &p : g->m.points_in_rectangle( top_left, bottom_right ) ) {
+        add( g->m.ter( p ).to_i() );
+        add( g->m.i_at( p ).size() );
+        add( g->m.get_field_strength( p, fd_fire ) );
+    }
+    for( wrapped_vehicle &veh : g->m.get_vehicles( top_left, bottom_right ) ) {
+        for( const vehicle_part &part : veh.v->parts ) {
+            add( part.hp() );
+        }
+    }
+
+    jsout.start_object();
+    jsout.member( "blasts", blasts );
+    jsout.member( "ms_per_blast", seconds * 1e3 / blasts );
+    jsout.member( "monsters_left", survivors );
+    jsout.member( "digest", digest );
+    jsout.end_object();
+
+    clear_bubble( "t_dirt" );
+}
+
+int main( int argc, const char *argv[] )
+{
+    int turns = 1000;
+    unsigned int seed = 42;
+    std::string output;
+    std::vector<std::string> selected;
+    std::vector<std::string> mods = { "dda" };
+
+    for( int i = 1; i < argc; i++ ) {
+        const char *arg = argv[i];
+        const char *value = nullptr;
+        if( ( value = option_value( arg, "--turns=" ) ) != nullptr ) {
+            turns = std::max( 1, atoi( value ) );
+        } else if( ( value = option_value( arg, "--seed=" ) ) != nullptr ) {
+            seed = strtoul( value, nullptr, 10 );
+        } else if( ( value = option_value( arg, "--scenarios=" ) ) != nullptr ) {
+            selected = split( value, ',' );
+        } else if( ( value = option_value( arg, "--output=" ) ) != nullptr ) {
+            output = value;
+        } else if( ( value = option_value( arg, "--mods=" ) ) != nullptr ) {
+            for( const auto &mod : split( value, ',' ) ) {
+                if( std::find( mods.begin(), mods.end(), mod ) == mods.end() ) {
+                    mods.push_back( mod );
+                }
+            }
+        } else if( strcmp( arg, "--list" ) == 0 ) {
+            for( const auto &sc : bench_scenarios() ) {
+                printf( "%-16s %s\n", sc.name.c_str(), sc.description.c_str() );
+            }
+            return 0;
+        } else {
+            printf( "Usage: %s [options]\n", argv[0] );
+            printf( "  --turns=<n>                  Number of turns simulated per scenario (default 1000).\n" );
+            printf( "  --seed=<n>                   Random seed (default 42).\n" );
+            printf( "  --scenarios=<a,b,...>        Only run the given scenarios.\n" );
+            printf( "  --output=<file>              Write the JSON report to a file instead of stdout.\n" );
+            printf( "  --mods=<mod1,mod2,...>       Loads the list of mods.\n" );
+            printf( "  --list                       Lists the scenarios.\n" );
+            return strcmp( arg, "--help" ) == 0 ? 0 : 1;
+        }
+    }
+
+    std::vector<const bench_scenario *> scenarios;
+    for( const auto &sc : bench_scenarios() ) {
+        if( selected.empty() || std::find( selected.begin(), selected.end(), sc.name ) != selected.end() ) {
+            scenarios.push_back( &sc );
+        }
+    }
+    if( scenarios.size() < std::max<size_t>( selected.size(), 1 ) ) {
+        fprintf( stderr, "Unknown scenario, see --list.\n" );
+        return 1;
+    }
+
+    test_mode = true;
+    rng_set_seed( seed );
+
+    try {
+        init_global_game_state( mods );
+    } catch( const std::exception &err ) {
+        fprintf( stderr, "Terminated: %s\n", err.what() );
+        fprintf( stderr, "Make sure that you're in the correct working directory and your data isn't corrupted.\n" );
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream fout;
+    if( !output.empty() ) {
+        fout.open( output.c_str() );
+        if( !fout ) {
+            fprintf( stderr, "Unable to open %s for writing.\n", output.c_str() );
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &out = output.empty() ? std::cout : fout;
+    {
+        JsonOut jsout( out, true );
+        jsout.start_object();
+        jsout.member( "seed", seed );
+        jsout.member( "turns", turns );
+        jsout.member( "scenarios" );
+        jsout.start_array();
+        for( const bench_scenario *sc : scenarios ) {
+            // Each scenario starts from the same random state, independent of the ones before.
+            rng_set_seed( seed );
+            run_scenario( *sc, turns, jsout );
+        }
+        jsout.end_array();
+        rng_set_seed( seed );
+        jsout.member( "items" );
+        run_item_benchmark( jsout );
+        jsout.member( "submaps" );
+        run_submap_benchmark( jsout );
+        jsout.member( "lookups" );
+        run_lookup_benchmark( jsout );
+        rng_set_seed( seed );
+        jsout.member( "explosions" );
+        run_explosion_benchmark( jsout );
+        jsout.end_object();
+    }
+    out << std::endl;
+
+    g->delete_world( world_generator->active_world->world_name, true );
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include "bench_scenarios.h"
+
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "mtype.h"
+#include "player.h"
+#include "recipe_dictionary.h"
+#include "vehicle.h"
+#include "veh_type.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const int bubble_size = MAPSIZE * SEEX;
+static const tripoint bubble_center( bubble_size / 2, bubble_size / 2, 0 );
+
+static const mtype_id mon_zombie( "mon_zombie" );
+
+void clear_bubble( const std::string &terrain )
+{
+    while( g->num_zombies() > 0 ) {
+        g->remove_zombie( 0 );
+    }
+    g->unload_npcs();
+
+    const tripoint top_left( 0, 0, 0 );
+    const tripoint bottom_right( bubble_size - 1, bubble_size - 1, 0 );
+    for( wrapped_vehicle &veh : g->m.get_vehicles( top_left, bottom_right ) ) {
+        g->m.destroy_vehicle( veh.v );
+    }
+
+    const ter_id ter( terrain );
+    for( const tripoint &p : g->m.points_in_rectangle( top_left, bottom_right ) ) {
+        std::vector<field_id> fields;
+        for( const auto &fd : g->m.field_at( p ) ) {
+            fields.push_back( fd.first );
+        }
+        for( const field_id fd : fields ) {
+            g->m.remove_field( p, fd );
+        }
+        g->m.furn_set( p, furn_id( "f_null" ) );
+        g->m.ter_set( p, ter );
+        g->m.trap_set( p, trap_id( "tr_null" ) );
+        g->m.i_clear( p );
+    }
+
+    g->u.setpos( bubble_center );
+    g->m.build_map_cache( 0, true );
+}
+
+/** Outlines a rectangle with @p wall and fills the inside with @p floor. */
+static void build_room( const tripoint &top_left, int width, int height, const ter_id &wall,
+                        const ter_id &floor )
+{
+    const tripoint bottom_right = top_left + tripoint( width - 1, height - 1, 0 );
+    for( const tripoint &p : g->m.points_in_rectangle( top_left, bottom_right ) ) {
+        const bool edge = p.x == top_left.x || p.y == top_left.y ||
+                          p.x == bottom_right.x || p.y == bottom_right.y;
+        g->m.ter_set( p, edge ? wall : floor );
+    }
+}
+
+/**
+ * Builds a grid of furnished wooden houses separated by streets. Calls @p on_house
+ * with the top left corner of each house.
+ */
+static void build_town( const std::function<void( const tripoint & )> &on_house )
+{
+    static const int house_size = 10;
+    static const int street_width = 4;
+    const ter_id wall( "t_wall_wood" );
+    const ter_id floor( "t_floor" );
+    for( int y = street_width; y + house_size < bubble_size; y += house_size + street_width ) {
+        for( int x = street_width; x + house_size < bubble_size; x += house_size + street_width ) {
+            const tripoint corner( x, y, 0 );
+            build_room( corner, house_size, house_size, wall, floor );
+            g->m.ter_set( corner + tripoint( house_size / 2, house_size - 1, 0 ), ter_id( "t_door_c" ) );
+            g->m.ter_set( corner + tripoint( 0, house_size / 2, 0 ), ter_id( "t_window" ) );
+            g->m.ter_set( corner + tripoint( house_size - 1, house_size / 2, 0 ), ter_id( "t_window" ) );
+            g->m.furn_set( corner + tripoint( 2, 2, 0 ), furn_id( "f_bed" ) );
+            g->m.furn_set( corner + tripoint( 5, 2, 0 ), furn_id( "f_table" ) );
+            g->m.furn_set( corner + tripoint( 5, 3, 0 ), furn_id( "f_chair" ) );
+            g->m.furn_set( corner + tripoint( 7, 7, 0 ), furn_id( "f_bookcase" ) );
+            g->m.spawn_item( corner + tripoint( 5, 2, 0 ), "rag", 3 );
+            g->m.spawn_item( corner + tripoint( 7, 7, 0 ), "2x4", 2 );
+            on_house( corner );
+        }
+    }
+}
+
+/** Spawns @p count zombies evenly on a circle around the bubble center. */
+static void spawn_zombie_ring( int count, int radius )
+{
+    for( int i = 0; i < count; i++ ) {
+        const double angle = 2 * M_PI * i / count;
+        const tripoint p = bubble_center + tripoint( int( radius * cos( angle ) ), int( radius * sin( angle ) ), 0 );
+        g->summon_mon( mon_zombie, p );
+    }
+}
+
+static void setup_city_night()
+{
+    clear_bubble( "t_pavement" );
+    calendar::turn = DAYS( 1 ) + HOURS( 23 );
+    build_town( []( const tripoint & ) {} );
+    for( int i = 0; i < 4; i++ ) {
+        spawn_zombie_ring( 12, 15 + i * 12 );
+    }
+}
+
+static void setup_horde_siege()
+{
+    clear_bubble( "t_grass" );
+    calendar::turn = DAYS( 1 ) + HOURS( 12 );
+    build_room( bubble_center - tripoint( 8, 8, 0 ), 17, 17, ter_id( "t_wall" ), ter_id( "t_floor" ) );
+    spawn_zombie_ring( 100, 30 );
+    spawn_zombie_ring( 100, 45 );
+}
+
+static std::vector<vehicle *> convoy;
+
+static void setup_vehicle_convoy()
+{
+    clear_bubble( "t_pavement" );
+    calendar::turn = DAYS( 1 ) + HOURS( 12 );
+    convoy.clear();
+    for( int i = 0; i < 8; i++ ) {
+        const tripoint p = bubble_center + tripoint( ( i % 4 - 2 ) * 8, ( i / 4 ) * 12, 0 );
+        vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), p, -90, 100, 0 );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->tags.insert( "IN_CONTROL_OVERRIDE" );
+        veh->engine_on = true;
+        veh->cruise_velocity = veh->safe_velocity() / 2;
+        veh->velocity = veh->cruise_velocity;
+        convoy.push_back( veh );
+    }
+}
+
+static void convoy_turn( int )
+{
+    // Keep the convoy inside the reality bubble by moving it back to its start.
+    for( size_t i = 0; i < convoy.size(); i++ ) {
+        const tripoint start = bubble_center + tripoint( ( int( i ) % 4 - 2 ) * 8, ( int( i ) / 4 ) * 12, 0 );
+        tripoint pos = convoy[i]->global_pos3();
+        const tripoint displacement = start - pos;
+        if( displacement != tripoint( 0, 0, 0 ) ) {
+            convoy[i] = g->m.displace_vehicle( pos, displacement );
+        }
+    }
+    convoy.erase( std::remove( convoy.begin(), convoy.end(), nullptr ), convoy.end() );
+}
+
+static void setup_burning_town()
+{
+    clear_bubble( "t_grass" );
+    calendar::turn = DAYS( 1 ) + HOURS( 14 );
+    int house = 0;
+    build_town( [&house]( const tripoint & corner ) {
+        if( house++ % 3 == 0 ) {
+            g->m.add_field( corner + tripoint( 5, 3, 0 ), fd_fire, 3 );
+            g->m.add_field( corner + tripoint( 2, 2, 0 ), fd_fire, 2 );
+        }
+    } );
+}
+
+static void setup_crafting_base()
+{
+    clear_bubble( "t_grass" );
+    calendar::turn = DAYS( 1 ) + HOURS( 10 );
+    static const std::vector<std::string> stock = {{
+            "rag", "scrap", "nail", "2x4", "pipe", "steel_chunk", "hammer", "screwdriver",
+            "duct_tape", "string_36", "plastic_chunk", "log", "stick"
+        }
+    };
+    const tripoint corner = bubble_center - tripoint( 10, 10, 0 );
+    build_room( corner, 21, 21, ter_id( "t_wall_wood" ), ter_id( "t_floor" ) );
+    int index = 0;
+    for( const tripoint &p : g->m.points_in_rectangle( corner + tripoint( 1, 1, 0 ),
+            corner + tripoint( 19, 19, 0 ) ) ) {
+        if( p.x % 4 == 0 && p.y % 4 == 0 ) {
+            g->m.furn_set( p, furn_id( "f_table" ) );
+        }
+        g->m.spawn_item( p, stock[index++ % stock.size()], 5 );
+    }
+}
+
+static void crafting_base_turn( int turn )
+{
+    // The player checks what can be crafted from the stockpile every few turns.
+    if( turn % 10 != 0 ) {
+        return;
+    }
+    g->u.invalidate_crafting_inventory();
+    for( const auto &e : recipe_dict ) {
+        g->u.can_make( &e.second );
+    }
+}
+
+static void setup_sleeping()
+{
+    clear_bubble( "t_grass" );
+    calendar::turn = DAYS( 1 ) + HOURS( 22 );
+    build_town( []( const tripoint & ) {} );
+    g->m.furn_set( g->u.pos(), furn_id( "f_bed" ) );
+    g->u.set_fatigue( 500 );
+    g->u.fall_asleep( HOURS( 8 ) );
+}
+
+const std::vector<bench_scenario> &bench_scenarios()
+{
+    static const std::vector<bench_scenario> scenarios = {{
+            { "city_night", "grid of houses at night with zombies roaming the streets", setup_city_night, nullptr },
+            { "horde_siege", "200 zombies closing in on a walled compound", setup_horde_siege, nullptr },
+            { "vehicle_convoy", "8 cars driving at cruise speed", setup_vehicle_convoy, convoy_turn },
+            { "burning_town", "fire spreading through a town of wooden houses", setup_burning_town, nullptr },
+            { "crafting_base", "stockpile of crafting components with frequent recipe checks", setup_crafting_base, crafting_base_turn },
+            { "sleeping", "the player sleeping through the night in an empty town", setup_sleeping, nullptr },
+        }
+    };
+    return scenarios;
+}
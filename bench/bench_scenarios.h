@@ -0,0 +1,32 @@
+#pragma once
+#ifndef BENCH_SCENARIOS_H
+#define BENCH_SCENARIOS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * A scripted situation for the world simulation benchmark.
+ *
+ * The scenario starts on a cleared reality bubble with the player in the middle of it,
+ * @ref setup builds the situation and @ref per_turn (if set) is called before each
+ * simulated turn, e.g. to keep vehicles inside the bubble.
+ */
+struct bench_scenario {
+    std::string name;
+    std::string description;
+    std::function<void()> setup;
+    std::function<void( int turn )> per_turn;
+};
+
+/** All known scenarios, in the order they are run by default. */
+const std::vector<bench_scenario> &bench_scenarios();
+
+/**
+ * Removes monsters, NPCs, vehicles, fields, items and furniture from the reality bubble,
+ * covers it with @p terrain and puts the player in its center.
+ */
+void clear_bubble( const std::string &terrain );
+
+#endif
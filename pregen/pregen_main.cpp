@@ -0,0 +1,262 @@
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "json.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "options.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "rng.h"
+#include "save_writer.h"
+#include "worldfactory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/*
+ * Offline world pre-generation.
+ *
+ * Generates the overmaps around the origin of a world and the submaps of the overmap
+ * terrain tiles around the center of the origin overmap, then saves them in the normal
+ * save layout of the world, so the game loads them instead of generating them when the
+ * player first gets there.
+ *
+ * Every tile is generated from its own random stream derived from the seed and its
+ * position (see map::loadn), and the overmaps are generated in a fixed order, so the same
+ * seed gives the same world.
+ */
+
+/** Argument value if @p arg is of the form "<prefix>value", else nullptr. */
+static const char *option_value( const char *arg, const char *prefix )
+{
+    return strncmp( arg, prefix, strlen( prefix ) ) == 0 ? arg + strlen( prefix ) : nullptr;
+}
+
+static std::vector<std::string> split( const std::string &str, const char delim )
+{
+    std::vector<std::string> ret;
+    size_t start = 0;
+    while( start <= str.size() ) {
+        const size_t end = std::min( str.find( delim, start ), str.size() );
+        if( end > start ) {
+            ret.push_back( str.substr( start, end - start ) );
+        }
+        start = end + 1;
+    }
+    return ret;
+}
+
+static double seconds_since( const std::chrono::steady_clock::time_point &start )
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+/** Loads the game data and the world named @p world_name, a new world if that is empty. */
+static void init_global_game_state( const std::string &world_name,
+                                    const std::vector<std::string> &mods )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( "./" );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( FILENAMES["config_dir"] ) || !assure_dir_exist( FILENAMES["savedir"] ) ) {
+        throw std::runtime_error( "Unable to make config or save directory. Check permissions." );
+    }
+
+    get_options().init();
+    get_options().load();
+    init_colors();
+
+    g = new game;
+    g->load_static_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->get_all_worlds();
+    WORLDPTR world = nullptr;
+    if( world_name.empty() ) {
+        world = world_generator->make_new_world( mods );
+    } else if( world_generator->all_worlds.count( world_name ) > 0 ) {
+        world = world_generator->all_worlds[world_name];
+    } else {
+        throw std::runtime_error( "There is no world named " + world_name + "." );
+    }
+    if( world == nullptr ) {
+        throw std::runtime_error( "Unable to create the world." );
+    }
+    world_generator->set_active_world( world );
+
+    g->load_core_data();
+    g->load_world_modfiles( world_generator->active_world );
+}
+
+/** Overmap coordinates within @p radius of (0, 0), closest ones first. */
+static std::vector<point> overmaps_in_radius( const int radius )
+{
+    std::vector<point> result;
+    for( int ring = 0; ring <= radius; ring++ ) {
+        for( int y = -ring; y <= ring; y++ ) {
+            for( int x = -ring; x <= ring; x++ ) {
+                if( std::max( std::abs( x ), std::abs( y ) ) == ring ) {
+                    result.emplace_back( x, y );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+int main( int argc, const char *argv[] )
+{
+    std::string world_name;
+    std::vector<std::string> mods = { "dda" };
+    unsigned int seed = 42;
+    int overmap_radius = 0;
+    int tile_radius = 8;
+    // Overmap terrain tiles generated between two saves of the mapbuffer, limits memory use.
+    int save_interval = 256;
+    std::string output;
+
+    for( int i = 1; i < argc; i++ ) {
+        const char *arg = argv[i];
+        const char *value = nullptr;
+        if( ( value = option_value( arg, "--world=" ) ) != nullptr ) {
+            world_name = value;
+        } else if( ( value = option_value( arg, "--mods=" ) ) != nullptr ) {
+            for( const auto &mod : split( value, ',' ) ) {
+                if( std::find( mods.begin(), mods.end(), mod ) == mods.end() ) {
+                    mods.push_back( mod );
+                }
+            }
+        } else if( ( value = option_value( arg, "--seed=" ) ) != nullptr ) {
+            seed = strtoul( value, nullptr, 10 );
+        } else if( ( value = option_value( arg, "--overmaps=" ) ) != nullptr ) {
+            overmap_radius = std::max( 0, atoi( value ) );
+        } else if( ( value = option_value( arg, "--tiles=" ) ) != nullptr ) {
+            tile_radius = std::max( 0, atoi( value ) );
+        } else if( ( value = option_value( arg, "--save-interval=" ) ) != nullptr ) {
+            save_interval = std::max( 1, atoi( value ) );
+        } else if( ( value = option_value( arg, "--output=" ) ) != nullptr ) {
+            output = value;
+        } else {
+            printf( "Usage: %s [options]\n", argv[0] );
+            printf( "  --world=<name>               Existing world to generate in, a new one is created if not given.\n" );
+            printf( "  --mods=<mod1,mod2,...>       Mods of a new world.\n" );
+            printf( "  --seed=<n>                   Random seed (default 42).\n" );
+            printf( "  --overmaps=<n>               Overmaps generated around the origin overmap (default 0).\n" );
+            printf( "  --tiles=<n>                  Overmap terrain tiles generated around the center of the\n" );
+            printf( "                               origin overmap, down to the submaps (default 8).\n" );
+            printf( "  --save-interval=<n>          Tiles generated between two saves of the map (default 256).\n" );
+            printf( "  --output=<file>              Write the JSON report to a file instead of stdout.\n" );
+            return strcmp( arg, "--help" ) == 0 ? 0 : 1;
+        }
+    }
+
+    test_mode = true;
+
+    try {
+        init_global_game_state( world_name, mods );
+    } catch( const std::exception &err ) {
+        fprintf( stderr, "Terminated: %s\n", err.what() );
+        fprintf( stderr, "Make sure that you're in the correct working directory and your data isn't corrupted.\n" );
+        return EXIT_FAILURE;
+    }
+    // Seeded after loading the data, so the result doesn't depend on what loading draws.
+    rng_set_seed( seed );
+    g->set_seed( seed );
+    // Items are aged relative to the time they are generated at, use the start of a new game.
+    calendar::turn = HOURS( get_option<int>( "INITIAL_TIME" ) );
+    std::cerr << "Generating in world " << world_generator->active_world->world_name << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<point> overmaps = overmaps_in_radius( overmap_radius );
+    for( size_t i = 0; i < overmaps.size(); i++ ) {
+        overmap_buffer.get( overmaps[i].x, overmaps[i].y );
+        std::cerr << "Overmap " << i + 1 << "/" << overmaps.size() << std::endl;
+    }
+    overmap_buffer.save();
+    const double overmap_seconds = seconds_since( start );
+
+    const point center( OMAPX / 2, OMAPY / 2 );
+    std::vector<point> tiles;
+    for( int y = center.y - tile_radius; y <= center.y + tile_radius; y++ ) {
+        for( int x = center.x - tile_radius; x <= center.x + tile_radius; x++ ) {
+            tiles.emplace_back( x, y );
+        }
+    }
+
+    int generated = 0;
+    int existing = 0;
+    double save_seconds = 0;
+    const auto save_map = [&save_seconds]() {
+        const auto save_start = std::chrono::steady_clock::now();
+        MAPBUFFER.save( true );
+        save_seconds += seconds_since( save_start );
+    };
+    start = std::chrono::steady_clock::now();
+    size_t next_report = 0;
+    for( size_t i = 0; i < tiles.size(); i++ ) {
+        const point sm = omt_to_sm_copy( tiles[i] );
+        // Looking the submap up also loads it if it was saved before.
+        if( MAPBUFFER.lookup_submap( sm.x, sm.y, 0 ) != nullptr ) {
+            existing++;
+        } else {
+            tinymap tm;
+            tm.load( sm.x, sm.y, 0, false );
+            generated++;
+        }
+        if( ( i + 1 ) % save_interval == 0 ) {
+            save_map();
+        }
+        if( i + 1 >= next_report || i + 1 == tiles.size() ) {
+            const double seconds = seconds_since( start );
+            fprintf( stderr, "Tiles %zu/%zu (%d%%), %.2f ms per generated tile\n", i + 1, tiles.size(),
+                     static_cast<int>( ( i + 1 ) * 100 / tiles.size() ),
+                     generated > 0 ? seconds * 1e3 / generated : 0.0 );
+            next_report += std::max<size_t>( 1, tiles.size() / 20 );
+        }
+    }
+    save_map();
+    const double tile_seconds = seconds_since( start );
+    // Overmaps get changed by the map generation (e.g. by placing vehicles and NPCs).
+    overmap_buffer.save();
+    // Saving only queues the files, they are written in the background.
+    const auto write_start = std::chrono::steady_clock::now();
+    const bool written = save_writer::wait();
+    save_seconds += seconds_since( write_start );
+    if( !written ) {
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream fout;
+    if( !output.empty() ) {
+        fout.open( output.c_str() );
+        if( !fout ) {
+            fprintf( stderr, "Unable to open %s for writing.\n", output.c_str() );
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &out = output.empty() ? std::cout : fout;
+    {
+        JsonOut jsout( out, true );
+        jsout.start_object();
+        jsout.member( "world", world_generator->active_world->world_name );
+        jsout.member( "seed", seed );
+        jsout.member( "overmaps", static_cast<int>( overmaps.size() ) );
+        jsout.member( "overmap_seconds", overmap_seconds );
+        jsout.member( "tiles_generated", generated );
+        jsout.member( "tiles_existing", existing );
+        jsout.member( "tile_seconds", tile_seconds );
+        jsout.member( "ms_per_generated_tile", generated > 0 ? tile_seconds * 1e3 / generated : 0.0 );
+        jsout.member( "save_seconds", save_seconds );
+        jsout.end_object();
+    }
+    out << std::endl;
+    return 0;
+}
@@ -148,7 +148,7 @@ void advanced_inventory::load_settings()
         panes[i].set_area(square, show_vehicle);
         panes[i].sortby = static_cast<advanced_inv_sortby>(uistate.adv_inv_sort[i]);
         panes[i].index = uistate.adv_inv_index[i];
-        panes[i].filter = uistate.adv_inv_filter[i];
+        panes[i].set_filter( uistate.adv_inv_filter[i] );
     }
     uistate.adv_inv_exit_code = exit_none;
 }
@@ -830,15 +830,10 @@ bool advanced_inventory_pane::is_filtered( const item *it ) const
         return false;
     }
 
-    std::string str = it->tname();
-    if( filtercache.find( str ) == filtercache.end() ) {
-        const auto filter_fn = item_filter_from_string( filter );
-        filtercache[ str ] = filter_fn;
-
-        return !filter_fn( *it );
+    if( !filter_fn ) {
+        filter_fn = item_filter_from_string( filter );
     }
-
-    return !filtercache[ str ]( *it );
+    return !filter_fn( *it );
 }
 
 // roll our own, to handle moving stacks better
@@ -1844,7 +1839,7 @@ void advanced_inventory_pane::set_filter( const std::string &new_filter )
         return;
     }
     filter = new_filter;
-    filtercache.clear();
+    filter_fn = nullptr;
     recalc = true;
 }
 
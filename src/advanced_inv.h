@@ -314,7 +314,8 @@ class advanced_inventory_pane
         /** Only add offset to index, but wrap around! */
         void mod_index( int offset );
 
-        mutable std::map<std::string, std::function<bool( const item & )>> filtercache;
+        /** @ref filter compiled by item_filter_from_string, empty until first needed. */
+        mutable std::function<bool( const item & )> filter_fn;
 };
 
 class advanced_inventory
@@ -6,6 +6,11 @@
 #include "mtype.h"
 #include "weather.h"
 #include "player.h"
+#include "calendar.h"
+#include "input.h"
+
+#include <algorithm>
+#include <array>
 #ifdef TILES
 #include "cata_tiles.h" // all animation functions will be pushed out to a cata_tiles function in some manner
 #include <memory>
@@ -29,16 +34,82 @@ tripoint relative_view_pos( player const &u, tripoint const &p ) noexcept
     return relative_view_pos( u, p.x, p.y, p.z );
 }
 
-void draw_animation_delay(long const scale = 1)
+enum animation_kind : int {
+    ANIMATION_PROJECTILE,
+    ANIMATION_EXPLOSION,
+    ANIMATION_HIT,
+    NUM_ANIMATION_KINDS
+};
+
+/** Option with the time (in ms per turn) the animations of a kind may pause the game. */
+char const *const animation_budget_option[NUM_ANIMATION_KINDS] = {
+    "ANIMATION_BUDGET_PROJECTILE",
+    "ANIMATION_BUDGET_EXPLOSION",
+    "ANIMATION_BUDGET_HIT"
+};
+
+/** Whether a key press is waiting to be handled, it stays in the input queue. */
+bool input_pending()
+{
+#if !(defined TILES || defined _WIN32 || defined WINDOWS)
+    const int old_timeout = inp_mngr.get_timeout();
+    inp_mngr.set_timeout( 0 );
+    const int key = getch();
+    inp_mngr.set_timeout( old_timeout );
+    if( key == ERR ) {
+        return false;
+    }
+    ungetch( key );
+    return true;
+#else
+    // Tiles and Windows builds can not put the key back, only the budgets apply there.
+    return false;
+#endif
+}
+
+/**
+ * Time spent pausing for animation frames during the current turn. Once the budget of a
+ * kind of animation is used up (e.g. by a long burst of automatic fire or a chain of
+ * explosions), its further frames of that turn are drawn without pausing, so they show up
+ * all at once. A key press skips the pauses of all animations for the rest of the turn.
+ */
+struct animation_pacing {
+    int turn = -1;
+    std::array<long, NUM_ANIMATION_KINDS> spent_ms;
+    bool skipping = false;
+
+    void start_turn() {
+        if( turn != calendar::turn ) {
+            turn = calendar::turn;
+            spent_ms.fill( 0 );
+            skipping = false;
+        }
+    }
+};
+
+animation_pacing pacing;
+
+void draw_animation_delay( animation_kind const kind, long const scale = 1 )
 {
     refresh_display();
 
-    auto const delay = get_option<int>( "ANIMATION_DELAY" ) * scale * 1000000l;
-
-    timespec const ts = {0, delay};
-    if (ts.tv_nsec > 0) {
-        nanosleep(&ts, nullptr);
+    pacing.start_turn();
+    long delay_ms = get_option<int>( "ANIMATION_DELAY" ) * scale;
+    const long budget_ms = get_option<int>( animation_budget_option[kind] );
+    if( budget_ms > 0 ) {
+        delay_ms = std::min( delay_ms, budget_ms - pacing.spent_ms[kind] );
+    }
+    if( delay_ms <= 0 || pacing.skipping ) {
+        return;
     }
+    if( input_pending() ) {
+        pacing.skipping = true;
+        return;
+    }
+    pacing.spent_ms[kind] += delay_ms;
+
+    timespec const ts = { delay_ms / 1000, ( delay_ms % 1000 ) * 1000000l };
+    nanosleep(&ts, nullptr);
 }
 
 void draw_explosion_curses(game &g, const tripoint &center, int const r, nc_color const col)
@@ -63,7 +134,7 @@ void draw_explosion_curses(game &g, const tripoint &center, int const r, nc_colo
         }
 
         wrefresh(g.w_terrain);
-        draw_animation_delay(EXPLOSION_MULTIPLIER);
+        draw_animation_delay( ANIMATION_EXPLOSION, EXPLOSION_MULTIPLIER );
     }
 }
 
@@ -135,7 +206,7 @@ void draw_custom_explosion_curses( game &g,
         }
 
         wrefresh( g.w_terrain );
-        draw_animation_delay( EXPLOSION_MULTIPLIER );
+        draw_animation_delay( ANIMATION_EXPLOSION, EXPLOSION_MULTIPLIER );
     }
 }
 } // namespace
@@ -155,7 +226,7 @@ void game::draw_explosion( const tripoint &p, int const r, nc_color const col )
     for (int i = 1; i <= r; i++) {
         tilecontext->init_explosion( p, i ); // TODO not xpos ypos?
         wrefresh(w_terrain);
-        draw_animation_delay(EXPLOSION_MULTIPLIER);
+        draw_animation_delay( ANIMATION_EXPLOSION, EXPLOSION_MULTIPLIER );
     }
 
     if (r > 0) {
@@ -294,7 +365,7 @@ void game::draw_custom_explosion( const tripoint &, const std::map<tripoint, nc_
         combined_layer.insert( layer.begin(), layer.end() );
         tilecontext->init_custom_explosion_layer( combined_layer );
         wrefresh(w_terrain);
-        draw_animation_delay(EXPLOSION_MULTIPLIER);
+        draw_animation_delay( ANIMATION_EXPLOSION, EXPLOSION_MULTIPLIER );
     }
 
     tilecontext->void_custom_explosion();
@@ -321,7 +392,7 @@ void draw_bullet_curses(WINDOW *const w, player &u, map &m, const tripoint &t,
     wrefresh(w);
 
     if (wait) {
-        draw_animation_delay();
+        draw_animation_delay( ANIMATION_PROJECTILE );
     }
 }
 
@@ -362,7 +433,7 @@ void game::draw_bullet(Creature const &p, const tripoint &t, int const i,
     wrefresh(w_terrain);
 
     if( p.is_player() ) {
-        draw_animation_delay();
+        draw_animation_delay( ANIMATION_PROJECTILE );
     }
 
     tilecontext->void_bullet();
@@ -398,7 +469,7 @@ void game::draw_hit_mon( const tripoint &p, const monster &m, bool const dead )
 
     tilecontext->init_draw_hit( p, m.type->id.str() );
     wrefresh(w_terrain);
-    draw_animation_delay();
+    draw_animation_delay( ANIMATION_HIT );
 }
 #else
 void game::draw_hit_mon( const tripoint &p, const monster &m, bool const dead )
@@ -438,7 +509,7 @@ void game::draw_hit_player(player const &p, const int dam)
 
     tilecontext->init_draw_hit( p.pos(), type );
     wrefresh(w_terrain);
-    draw_animation_delay();
+    draw_animation_delay( ANIMATION_HIT );
 }
 #else
 void game::draw_hit_player(player const &p, const int dam)
@@ -379,10 +379,10 @@ void auto_pickup::test_pattern(const int iTab, const int iRow)
 
     //Loop through all itemfactory items
     //APU now ignores prefixes, bottled items and suffix combinations still not generated
+    const wildcard_pattern pattern( vRules[iTab][iRow].sRule );
     for( const itype *e : item_controller->all() ) {
         sItemName = e->nname(1);
-        if (vRules[iTab][iRow].bActive &&
-            wildcard_match(sItemName, vRules[iTab][iRow].sRule)) {
+        if( vRules[iTab][iRow].bActive && pattern.matches( sItemName ) ) {
             vMatchingItems.push_back(sItemName);
         }
     }
@@ -484,7 +484,16 @@ bool auto_pickup::has_rule(const std::string &sRule)
 void auto_pickup::add_rule(const std::string &sRule)
 {
     vRules[CHARACTER_TAB].push_back(cRules(sRule, true, false));
-    create_rule(sRule);
+    if( ready && !sRule.empty() ) {
+        // The new rule comes last, so it decides the state of every name it matches.
+        compiled_rules.push_back( compiled_rule{ wildcard_pattern( sRule ), RULE_WHITELISTED } );
+        const wildcard_pattern &pattern = compiled_rules.back().pattern;
+        for( auto &elem : map_items ) {
+            if( pattern.matches( elem.first ) ) {
+                elem.second = RULE_WHITELISTED;
+            }
+        }
+    }
 
     if (!get_option<bool>( "AUTO_PICKUP" ) &&
         query_yn(_("Autopickup is not enabled in the options. Enable it now?")) ) {
@@ -499,8 +508,18 @@ void auto_pickup::remove_rule(const std::string &sRule)
          it != vRules[CHARACTER_TAB].end(); ++it) {
         if (sRule.length() == it->sRule.length() &&
             ci_find_substr(sRule, it->sRule) != -1) {
+            const cRules removed = *it;
             vRules[CHARACTER_TAB].erase(it);
-            ready = false;
+            if( ready && removed.bActive && !removed.sRule.empty() ) {
+                // Only the names the removed rule matched can change their state.
+                refresh_rules();
+                const wildcard_pattern pattern( removed.sRule );
+                for( auto &elem : map_items ) {
+                    if( pattern.matches( elem.first ) ) {
+                        elem.second = evaluate( elem.first );
+                    }
+                }
+            }
             break;
         }
     }
@@ -517,61 +536,38 @@ bool auto_pickup::empty() const
     return true;
 }
 
-void auto_pickup::create_rule( const std::string &to_match )
+void auto_pickup::refresh_rules() const
 {
+    compiled_rules.clear();
+
+    //process include/exclude in order of rules, global first, then character specific
     for( int i = GLOBAL_TAB; i < MAX_TAB; i++ ) {
         for( auto &elem : vRules[i] ) {
-            if( !elem.bExclude ) {
-                if( elem.bActive && wildcard_match( to_match, elem.sRule ) ) {
-                    map_items[ to_match ] = RULE_WHITELISTED;
-                }
-            } else {
-                if( elem.bActive && wildcard_match( to_match, elem.sRule ) ) {
-                    map_items[ to_match ] = RULE_BLACKLISTED;
-                }
+            if( elem.bActive && elem.sRule != "" ) {
+                compiled_rules.push_back( compiled_rule{ wildcard_pattern( elem.sRule ),
+                                                         elem.bExclude ? RULE_BLACKLISTED : RULE_WHITELISTED } );
             }
         }
     }
+
+    ready = true;
 }
 
-void auto_pickup::refresh_map_items() const
+rule_state auto_pickup::evaluate( const std::string &sItemName ) const
 {
-    map_items.clear();
-
-    //process include/exclude in order of rules, global first, then character specific
-    //if a specific item is being added, all the rules need to be checked now
-    //may have some performance issues since exclusion needs to check all items also
-    for( int i = GLOBAL_TAB; i < MAX_TAB; i++ ) {
-        for( auto &elem : vRules[i] ) {
-            if ( elem.sRule != "" ) {
-                if( !elem.bExclude ) {
-                    //Check include patterns against all itemfactory items
-                    for( const itype *e : item_controller->all() ) {
-                        const std::string &cur_item = e->nname( 1 );
-                        if( elem.bActive && wildcard_match( cur_item, elem.sRule ) ) {
-                            map_items[ cur_item ] = RULE_WHITELISTED;
-                        }
-                    }
-                } else {
-                    //only re-exclude items from the existing mapping for now
-                    //new exclusions will process during pickup attempts
-                    for (auto iter = map_items.begin(); iter != map_items.end(); ++iter) {
-                        if( elem.bActive && wildcard_match( iter->first, elem.sRule ) ) {
-                            map_items[ iter->first ] = RULE_BLACKLISTED;
-                        }
-                    }
-                }
-            }
+    for( auto it = compiled_rules.rbegin(); it != compiled_rules.rend(); ++it ) {
+        if( it->pattern.matches( sItemName ) ) {
+            return it->state;
         }
     }
-
-    ready = true;
+    return RULE_NONE;
 }
 
 rule_state auto_pickup::check_item( const std::string &sItemName ) const
 {
     if( !ready ) {
-        refresh_map_items();
+        refresh_rules();
+        map_items.clear();
     }
 
     const auto iter = map_items.find( sItemName );
@@ -579,7 +575,9 @@ rule_state auto_pickup::check_item( const std::string &sItemName ) const
         return iter->second;
     }
 
-    return RULE_NONE;
+    const rule_state state = evaluate( sItemName );
+    map_items[ sItemName ] = state;
+    return state;
 }
 
 void auto_pickup::clear_character_rules()
@@ -10,6 +10,7 @@
 #include <iosfwd>
 #include "json.h"
 #include "enums.h"
+#include "output.h"
 
 class auto_pickup : public JsonSerializer, public JsonDeserializer
 {
@@ -49,13 +50,25 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
                 ~cRules() {};
         };
 
-        mutable bool ready; //< true if map_items has been populated from vRules
+        mutable bool ready; //< true if compiled_rules matches vRules
+
+        /** An active rule from vRules, with its pattern prepared for matching. */
+        struct compiled_rule {
+            wildcard_pattern pattern;
+            rule_state state;
+        };
+
+        /**
+         * The currently-active auto-pickup rules in the order they apply (global first,
+         * then character specific), filled by @ref auto_pickup::refresh_rules(). The last
+         * rule that matches an item name decides its state.
+         */
+        mutable std::vector<compiled_rule> compiled_rules;
 
         /**
-         * The currently-active set of auto-pickup rules, in a form that allows quick
-         * lookup. When this is filled (by @ref auto_pickup::create_rule()), every
-         * item existing in the game that matches a rule (either white- or blacklist)
-         * is added as the key, with RULE_WHITELISTED or RULE_BLACKLISTED as the values.
+         * Every item name that has been checked so far, with the result of the check
+         * (including RULE_NONE), so an item seen again costs a single lookup. Kept up to
+         * date when rules are added or removed, cleared on all other changes.
          */
         mutable std::unordered_map<std::string, rule_state> map_items;
 
@@ -67,7 +80,8 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
 
         void load_legacy_rules( std::vector<cRules> &rules, std::istream &fin );
 
-        void refresh_map_items() const; //< Only modifies mutable state
+        void refresh_rules() const; //< Only modifies mutable state
+        rule_state evaluate( const std::string &sItemName ) const;
 
     public:
         auto_pickup() : bChar( false ), ready( false ) {}
@@ -75,7 +89,6 @@ class auto_pickup : public JsonSerializer, public JsonDeserializer
         bool has_rule( const std::string &sRule );
         void add_rule( const std::string &sRule );
         void remove_rule( const std::string &sRule );
-        void create_rule( const std::string &to_match );
         void clear_character_rules();
         rule_state check_item( const std::string &sItemName ) const;
 
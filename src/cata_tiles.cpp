@@ -119,10 +119,12 @@ void cata_tiles::clear()
 {
     // release maps
     tile_values.clear();
+    atlases.clear();
     shadow_tile_values.clear();
     night_tile_values.clear();
     overexposed_tile_values.clear();
     tile_ids.clear();
+    clear_tile_lookup_cache();
     // release minimap
     minimap_cache.clear();
     tex_pool.texture_pool.clear();
@@ -347,78 +349,86 @@ int cata_tiles::load_tileset(std::string img_path, int R, int G, int B, int spri
     sx *= sprite_width;
     sy *= sprite_height;
 
-    /** Set up initial source and destination information. Destination is going to be unchanging */
-    SDL_Rect source_rect = {0, 0, sprite_width, sprite_height};
-    SDL_Rect dest_rect = {0, 0, sprite_width, sprite_height};
+    /**
+     * Sprites are drawn straight out of the tileset image, which is uploaded as one
+     * texture per color variant. Images larger than the maximal texture size of the
+     * renderer are split into several atlas textures.
+     */
+    SDL_RendererInfo info;
+    int max_tex_width = sx;
+    int max_tex_height = sy;
+    if( SDL_GetRendererInfo( renderer, &info ) == 0 ) {
+        if( info.max_texture_width > 0 ) {
+            max_tex_width = std::max( sprite_width, info.max_texture_width / sprite_width * sprite_width );
+        }
+        if( info.max_texture_height > 0 ) {
+            max_tex_height = std::max( sprite_height, info.max_texture_height / sprite_height * sprite_height );
+        }
+    } else {
+        dbg( D_ERROR ) << "SDL_GetRendererInfo failed: " << SDL_GetError();
+    }
+    const int chunk_width = std::min( sx, max_tex_width );
+    const int chunk_height = std::min( sy, max_tex_height );
+    const int chunks_x = chunk_width > 0 ? ( sx + chunk_width - 1 ) / chunk_width : 0;
+    const int chunks_y = chunk_height > 0 ? ( sy + chunk_height - 1 ) / chunk_height : 0;
+
+    const bool use_color_key = R >= 0 && R <= 255 && G >= 0 && G <= 255 && B >= 0 && B <= 255;
+    const auto make_atlas = [&]( SDL_Surface * const source, int x, int y ) -> SDL_Texture * {
+        SDL_Rect source_rect = { x, y, std::min( chunk_width, sx - x ), std::min( chunk_height, sy - y ) };
+        SDL_Rect dest_rect = { 0, 0, source_rect.w, source_rect.h };
+        SDL_Surface_Ptr chunk_surf = create_tile_surface( source_rect.w, source_rect.h );
+        if( !chunk_surf ) {
+            return nullptr;
+        }
+        if( SDL_BlitSurface( source, &source_rect, chunk_surf.get(), &dest_rect ) != 0 ) {
+            dbg( D_ERROR ) << "SDL_BlitSurface failed: " << SDL_GetError();
+        }
+        if( use_color_key ) {
+            Uint32 key = SDL_MapRGB( chunk_surf->format, 0, 0, 0 );
+            SDL_SetColorKey( chunk_surf.get(), SDL_TRUE, key );
+            SDL_SetSurfaceRLE( chunk_surf.get(), true );
+        }
+        SDL_Texture_Ptr atlas_tex( SDL_CreateTextureFromSurface( renderer, chunk_surf.get() ) );
+        if( !atlas_tex ) {
+            dbg( D_ERROR ) << "failed to create texture: " << SDL_GetError();
+            return nullptr;
+        }
+        atlases.push_back( std::move( atlas_tex ) );
+        return atlases.back().get();
+    };
+
+    /** atlas textures of each color variant, indexed by chunk row * chunks_x + chunk column */
+    std::vector<SDL_Texture *> tile_chunks, shadow_chunks, night_chunks, overexposed_chunks;
+    for( int cy = 0; cy < chunks_y; ++cy ) {
+        for( int cx = 0; cx < chunks_x; ++cx ) {
+            const int x = cx * chunk_width;
+            const int y = cy * chunk_height;
+            tile_chunks.push_back( make_atlas( tile_atlas.get(), x, y ) );
+            shadow_chunks.push_back( make_atlas( shadow_tile_atlas.get(), x, y ) );
+            night_chunks.push_back( make_atlas( nightvision_tile_atlas.get(), x, y ) );
+            overexposed_chunks.push_back( make_atlas( overexposed_tile_atlas.get(), x, y ) );
+        }
+    }
 
-    /** split the atlas into tiles using SDL_Rect structs instead of slicing the atlas into individual surfaces */
+    /** split the atlas into tiles using SDL_Rect structs instead of slicing the atlas into individual textures */
     int tilecount = 0;
     for( int y = 0; y < sy; y += sprite_height ) {
         for( int x = 0; x < sx; x += sprite_width ) {
-            source_rect.x = x;
-            source_rect.y = y;
-
-            SDL_Surface_Ptr tile_surf = create_tile_surface(sprite_width, sprite_height);
-            if( !tile_surf ) {
-                continue;
-            }
-
-            if( SDL_BlitSurface( tile_atlas.get(), &source_rect, tile_surf.get(), &dest_rect ) != 0 ) {
-                dbg( D_ERROR ) << "SDL_BlitSurface failed: " << SDL_GetError();
-            }
-
-            if( R >= 0 && R <= 255 && G >= 0 && G <= 255 && B >= 0 && B <= 255 ) {
-                Uint32 key = SDL_MapRGB(tile_surf->format, 0, 0, 0);
-                SDL_SetColorKey(tile_surf.get(), SDL_TRUE, key);
-                SDL_SetSurfaceRLE(tile_surf.get(), true);
-            }
-
-            SDL_Texture_Ptr tile_tex( SDL_CreateTextureFromSurface( renderer, tile_surf.get() ) );
-
-            if( !tile_tex ) {
-                dbg( D_ERROR) << "failed to create texture: " << SDL_GetError();
-            }
+            const size_t chunk = ( y / chunk_height ) * chunks_x + x / chunk_width;
+            const SDL_Rect source_rect = { x % chunk_width, y % chunk_height, sprite_width, sprite_height };
 
-            /** reuse the surface to make alternate color filtered versions */
-            if( SDL_BlitSurface( shadow_tile_atlas.get(), &source_rect, tile_surf.get(), &dest_rect ) != 0 ) {
-                dbg( D_ERROR ) << "SDL_BlitSurface failed: " << SDL_GetError();
-            }
-
-            SDL_Texture_Ptr shadow_tile_tex( SDL_CreateTextureFromSurface( renderer, tile_surf.get() ) );
-            if( !shadow_tile_tex ) {
-                dbg( D_ERROR) << "failed to create texture: " << SDL_GetError();
-            }
-
-            if( SDL_BlitSurface( nightvision_tile_atlas.get(), &source_rect, tile_surf.get(), &dest_rect ) != 0 ) {
-                dbg( D_ERROR ) << "SDL_BlitSurface failed: " << SDL_GetError();
-            }
-
-            SDL_Texture_Ptr night_tile_tex( SDL_CreateTextureFromSurface( renderer, tile_surf.get() ) );
-            if( !night_tile_tex ) {
-                dbg( D_ERROR) << "failed to create texture: " << SDL_GetError();
-            }
-
-            if( SDL_BlitSurface( overexposed_tile_atlas.get(), &source_rect, tile_surf.get(), &dest_rect ) != 0 ) {
-                dbg( D_ERROR ) << "SDL_BlitSurface failed: " << SDL_GetError();
-            }
-
-            SDL_Texture_Ptr overexposed_tile_tex( SDL_CreateTextureFromSurface( renderer, tile_surf.get() ) );
-            if( overexposed_tile_tex == nullptr ) {
-                dbg( D_ERROR) << "failed to create texture: " << SDL_GetError();
-            }
-
-            if( tile_tex ) {
-                tile_values.push_back( std::move( tile_tex ) );
+            if( tile_chunks[chunk] ) {
+                tile_values.push_back( texture( tile_chunks[chunk], source_rect ) );
                 tilecount++;
             }
-            if( shadow_tile_tex ) {
-                shadow_tile_values.push_back( std::move( shadow_tile_tex ) );
+            if( shadow_chunks[chunk] ) {
+                shadow_tile_values.push_back( texture( shadow_chunks[chunk], source_rect ) );
             }
-            if( night_tile_tex ) {
-                night_tile_values.push_back( std::move( night_tile_tex ) );
+            if( night_chunks[chunk] ) {
+                night_tile_values.push_back( texture( night_chunks[chunk], source_rect ) );
             }
-            if( overexposed_tile_tex ) {
-                overexposed_tile_values.push_back( std::move( overexposed_tile_tex ) );
+            if( overexposed_chunks[chunk] ) {
+                overexposed_tile_values.push_back( texture( overexposed_chunks[chunk], source_rect ) );
             }
         }
     }
@@ -448,6 +458,7 @@ void cata_tiles::load_tilejson(std::string tileset_root, std::string json_conf,
     }
 
     load_tilejson_from_file(tileset_root, config_file, img_path);
+    clear_tile_lookup_cache();
     if (tile_ids.count("unknown") == 0) {
         dbg( D_ERROR ) << "The tileset you're using has no 'unknown' tile defined!";
     }
@@ -873,6 +884,10 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
         SDL_RenderFillRect(renderer, &clipRect);
     }
 
+    if( tile_lookup_season != calendar::turn.get_season() ) {
+        clear_tile_lookup_cache();
+    }
+
     int posx = center.x;
     int posy = center.y;
 
@@ -1456,20 +1471,9 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
     }
 
 
-    constexpr size_t suffix_len = 15;
-    constexpr char season_suffix[4][suffix_len] = {
-        "_season_spring", "_season_summer", "_season_autumn", "_season_winter"};
-
-    std::string seasonal_id = id + season_suffix[calendar::turn.get_season()];
-
-    auto it = tile_ids.find(seasonal_id);
-    if (it == tile_ids.end()) {
-        it = tile_ids.find(id);
-    } else {
-        id = std::move(seasonal_id);
-    }
+    const tile_type *tt = find_tile_with_season( id );
 
-    if (it == tile_ids.end()) {
+    if( tt == nullptr ) {
         uint32_t sym = UNKNOWN_UNICODE;
         nc_color col = c_white;
         if (category == C_FURNITURE) {
@@ -1567,8 +1571,9 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
         }
     }
 
+    auto it = tile_ids.end();
     // if id is not found, try to find a tile for the category+subcategory combination
-    if (it == tile_ids.end()) {
+    if( tt == nullptr ) {
         const std::string &category_id = TILE_CATEGORY_IDS[category];
         if(!category_id.empty() && !subcategory.empty()) {
             it = tile_ids.find("unknown_" + category_id + "_" + subcategory);
@@ -1576,7 +1581,7 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
     }
 
     // if at this point we have no tile, try just the category
-    if (it == tile_ids.end()) {
+    if( tt == nullptr && it == tile_ids.end() ) {
         const std::string &category_id = TILE_CATEGORY_IDS[category];
         if(!category_id.empty()) {
             it = tile_ids.find("unknown_" + category_id);
@@ -1584,16 +1589,20 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
     }
 
     // if we still have no tile, we're out of luck, fall back to unknown
-    if (it == tile_ids.end()) {
+    if( tt == nullptr && it == tile_ids.end() ) {
         it = tile_ids.find("unknown");
     }
 
+    if( tt == nullptr && it != tile_ids.end() ) {
+        tt = &it->second;
+    }
+
     //  this really shouldn't happen, but the tileset creator might have forgotten to define an unknown tile
-    if (it == tile_ids.end()) {
+    if( tt == nullptr ) {
         return false;
     }
 
-    tile_type &display_tile = it->second;
+    const tile_type &display_tile = *tt;
     // check to see if the display_tile is multitile, and if so if it has the key related to subtile
     if (subtile != -1 && display_tile.multitile) {
         auto const &display_subtiles = display_tile.available_subtiles;
@@ -1606,6 +1615,74 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
         }
     }
 
+    return draw_tile_at_pos( display_tile, id, category, pos, rota, ll, apply_night_vision_goggles,
+                             height_3d );
+}
+
+const tile_type *cata_tiles::find_tile_with_season( std::string &id ) const
+{
+    constexpr size_t suffix_len = 15;
+    constexpr char season_suffix[4][suffix_len] = {
+        "_season_spring", "_season_summer", "_season_autumn", "_season_winter"};
+
+    std::string seasonal_id = id + season_suffix[calendar::turn.get_season()];
+
+    auto it = tile_ids.find( seasonal_id );
+    if( it == tile_ids.end() ) {
+        it = tile_ids.find( id );
+    } else {
+        id = std::move( seasonal_id );
+    }
+    return it == tile_ids.end() ? nullptr : &it->second;
+}
+
+const tile_lookup_res &cata_tiles::find_tile_cached( std::vector<tile_lookup_set> &table,
+        const size_t index, const int subtile, const std::string &id )
+{
+    if( index >= table.size() ) {
+        table.resize( index + 1 );
+    }
+    tile_lookup_res &res = table[index][subtile + 1];
+    if( res.resolved ) {
+        return res;
+    }
+    res.resolved = true;
+
+    std::string found_id = id;
+    const tile_type *tt = find_tile_with_season( found_id );
+    if( tt != nullptr && subtile != -1 && tt->multitile ) {
+        // Mirrors the subtile recursion in draw_from_id_string
+        auto const &display_subtiles = tt->available_subtiles;
+        auto const end = std::end( display_subtiles );
+        if( std::find( begin( display_subtiles ), end, multitile_keys[subtile] ) != end ) {
+            found_id.append( "_", 1 ).append( multitile_keys[subtile] );
+            tt = find_tile_with_season( found_id );
+            res.is_subtile = true;
+        }
+    }
+    res.tile = tt;
+    return res;
+}
+
+void cata_tiles::clear_tile_lookup_cache()
+{
+    terrain_lookup.clear();
+    furniture_lookup.clear();
+    trap_lookup.clear();
+    field_lookup.clear();
+    tile_lookup_season = calendar::turn.get_season();
+}
+
+bool cata_tiles::draw_tile_at_pos( const tile_type &display_tile, const std::string &id,
+                                   TILE_CATEGORY category, tripoint pos, int rota, lit_level ll,
+                                   bool apply_night_vision_goggles, int &height_3d )
+{
+    if( !( tile_iso && use_tiles ) &&
+        ( pos.x - o_x < 0 || pos.x - o_x >= screentile_width ||
+          pos.y - o_y < 0 || pos.y - o_y >= screentile_height ) ) {
+        return false;
+    }
+
     // make sure we aren't going to rotate the tile if it shouldn't be rotated
     if (!display_tile.rotates) {
         rota = 0;
@@ -1749,25 +1826,26 @@ bool cata_tiles::draw_sprite_at( const tile_type &tile, const weighted_int_list<
             sprite_num = rota % spritelist.size();
         }
 
-        SDL_Texture *sprite_tex = tile_values[spritelist[sprite_num]].get();
+        const texture *sprite = &tile_values[spritelist[sprite_num]];
 
         //use night vision colors when in use
         //then use low light tile if available
         if(apply_night_vision_goggles && spritelist[sprite_num] < static_cast<int>(night_tile_values.size())){
             if(ll != LL_LOW){
                 //overexposed tile count should be the same size as night_tile_values.size
-                sprite_tex = overexposed_tile_values[spritelist[sprite_num]].get();
+                sprite = &overexposed_tile_values[spritelist[sprite_num]];
             } else {
-                sprite_tex = night_tile_values[spritelist[sprite_num]].get();
+                sprite = &night_tile_values[spritelist[sprite_num]];
             }
         }
         else if(ll == LL_LOW && spritelist[sprite_num] < static_cast<int>(shadow_tile_values.size())) {
-            sprite_tex = shadow_tile_values[spritelist[sprite_num]].get();
+            sprite = &shadow_tile_values[spritelist[sprite_num]];
         }
 
-        Uint32 format;
-        int access, width, height;
-        SDL_QueryTexture(sprite_tex, &format, &access, &width, &height);
+        SDL_Texture *sprite_tex = sprite->atlas;
+        const SDL_Rect *srcrect = &sprite->srcrect;
+        const int width = srcrect->w;
+        const int height = srcrect->h;
 
         SDL_Rect destination;
         destination.x = x + tile.offset.x * tile_width / default_tile_width;
@@ -1779,30 +1857,30 @@ bool cata_tiles::draw_sprite_at( const tile_type &tile, const weighted_int_list<
             switch ( rota ) {
                 default:
                 case 0: // unrotated (and 180, with just two sprites)
-                    ret = SDL_RenderCopyEx( renderer, sprite_tex, NULL, &destination,
+                    ret = SDL_RenderCopyEx( renderer, sprite_tex, srcrect, &destination,
                         0, NULL, SDL_FLIP_NONE );
                     break;
                 case 1: // 90 degrees (and 270, with just two sprites)
 #if (defined _WIN32 || defined WINDOWS)
                     destination.y -= 1;
 #endif
-                    ret = SDL_RenderCopyEx( renderer, sprite_tex, NULL, &destination,
+                    ret = SDL_RenderCopyEx( renderer, sprite_tex, srcrect, &destination,
                         -90, NULL, SDL_FLIP_NONE );
                     break;
                 case 2: // 180 degrees, implemented with flips instead of rotation
-                    ret = SDL_RenderCopyEx( renderer, sprite_tex, NULL, &destination,
+                    ret = SDL_RenderCopyEx( renderer, sprite_tex, srcrect, &destination,
                         0, NULL, static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
                     break;
                 case 3: // 270 degrees
 #if (defined _WIN32 || defined WINDOWS)
                     destination.x -= 1;
 #endif
-                    ret = SDL_RenderCopyEx( renderer, sprite_tex, NULL, &destination,
+                    ret = SDL_RenderCopyEx( renderer, sprite_tex, srcrect, &destination,
                         90, NULL, SDL_FLIP_NONE );
                     break;
             }
         } else { // don't rotate, same as case 0 above
-            ret = SDL_RenderCopyEx( renderer, sprite_tex, NULL, &destination,
+            ret = SDL_RenderCopyEx( renderer, sprite_tex, srcrect, &destination,
                 0, NULL, SDL_FLIP_NONE );
         }
 
@@ -1941,6 +2019,11 @@ bool cata_tiles::draw_terrain( const tripoint &p, lit_level ll, int &height_3d )
 
     const std::string& tname = t.obj().id.str();
 
+    const tile_lookup_res &res = find_tile_cached( terrain_lookup, t.to_i(), subtile, tname );
+    if( res.tile != nullptr ) {
+        return draw_tile_at_pos( *res.tile, tname, res.is_subtile ? C_NONE : C_TERRAIN, p, rotation,
+                                 ll, nv_goggles_activated, height_3d );
+    }
     return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
                                 nv_goggles_activated, height_3d );
 }
@@ -1968,8 +2051,15 @@ bool cata_tiles::draw_furniture( const tripoint &p, lit_level ll, int &height_3d
 
     // get the name of this furniture piece
     const std::string& f_name = f_id.obj().id.str();
-    bool ret = draw_from_id_string( f_name, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                    nv_goggles_activated, height_3d );
+    const tile_lookup_res &res = find_tile_cached( furniture_lookup, f_id.to_i(), subtile, f_name );
+    bool ret;
+    if( res.tile != nullptr ) {
+        ret = draw_tile_at_pos( *res.tile, f_name, res.is_subtile ? C_NONE : C_FURNITURE, p, rotation,
+                                ll, nv_goggles_activated, height_3d );
+    } else {
+        ret = draw_from_id_string( f_name, C_FURNITURE, empty_string, p, subtile, rotation, ll,
+                                   nv_goggles_activated, height_3d );
+    }
     if( ret && g->m.sees_some_items( p, g->u ) ) {
         draw_item_highlight( p );
     }
@@ -1993,6 +2083,12 @@ bool cata_tiles::draw_trap( const tripoint &p, lit_level ll, int &height_3d )
     int subtile = 0, rotation = 0;
     get_tile_values(tr.loadid, neighborhood, subtile, rotation);
 
+    const tile_lookup_res &res = find_tile_cached( trap_lookup, tr.loadid.to_i(), subtile,
+                                 tr.id.str() );
+    if( res.tile != nullptr ) {
+        return draw_tile_at_pos( *res.tile, tr.id.str(), res.is_subtile ? C_NONE : C_TRAP, p, rotation,
+                                 ll, nv_goggles_activated, height_3d );
+    }
     return draw_from_id_string( tr.id.str(), C_TRAP, empty_string, p, subtile, rotation, ll,
                                nv_goggles_activated, height_3d );
 }
@@ -2045,7 +2141,7 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, lit_level ll, int &heigh
     bool ret_draw_field = true;
     bool ret_draw_item = true;
     if (is_draw_field) {
-        const std::string fd_name = fieldlist[f.fieldSymbol()].id;
+        const std::string &fd_name = fieldlist[f.fieldSymbol()].id;
 
         // for rotation inforomation
         const int neighborhood[4] = {
@@ -2058,8 +2154,15 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, lit_level ll, int &heigh
         int subtile = 0, rotation = 0;
         get_tile_values(f.fieldSymbol(), neighborhood, subtile, rotation);
 
-        ret_draw_field = draw_from_id_string( fd_name, C_FIELD, empty_string, p, subtile, rotation,
-                                              ll, nv_goggles_activated );
+        const tile_lookup_res &res = find_tile_cached( field_lookup, f.fieldSymbol(), subtile, fd_name );
+        if( res.tile != nullptr ) {
+            int nullint = 0;
+            ret_draw_field = draw_tile_at_pos( *res.tile, fd_name, res.is_subtile ? C_NONE : C_FIELD, p,
+                                               rotation, ll, nv_goggles_activated, nullint );
+        } else {
+            ret_draw_field = draw_from_id_string( fd_name, C_FIELD, empty_string, p, subtile, rotation,
+                                                  ll, nv_goggles_activated );
+        }
     }
     if(do_item) {
         if( !g->m.sees_some_items( p, g->u ) ) {
@@ -2252,13 +2355,15 @@ void cata_tiles::create_default_item_highlight()
         return;
     }
     SDL_FillRect(surface.get(), NULL, SDL_MapRGBA(surface->format, 0, 0, 127, highlight_alpha));
-    SDL_Texture_Ptr texture( SDL_CreateTextureFromSurface( renderer, surface.get() ) );
-    if( !texture ) {
+    SDL_Texture_Ptr highlight_tex( SDL_CreateTextureFromSurface( renderer, surface.get() ) );
+    if( !highlight_tex ) {
         dbg( D_ERROR ) << "Failed to create texture: " << SDL_GetError();
     }
 
-    if( texture ) {
-        tile_values.push_back( std::move( texture ) );
+    if( highlight_tex ) {
+        const SDL_Rect srcrect = { 0, 0, surface->w, surface->h };
+        tile_values.push_back( texture( highlight_tex.get(), srcrect ) );
+        atlases.push_back( std::move( highlight_tex ) );
         tile_ids[key].fg.add(std::vector<int>({index}),1);
     }
 }
@@ -11,7 +11,9 @@
 #include "tile_id_data.h"
 #include "enums.h"
 #include "weighted_list.h"
+#include "calendar.h"
 
+#include <array>
 #include <list>
 #include <map>
 #include <vector>
@@ -82,6 +84,21 @@ enum TILE_CATEGORY {
     C_WEATHER,
 };
 
+/**
+ * Result of resolving the id string of a drawn object (plus subtile) against the
+ * loaded tileset for the current season, see @ref cata_tiles::find_tile_cached.
+ */
+struct tile_lookup_res {
+    /** The tile to draw, nullptr if the slow fallback lookup must be used. */
+    const tile_type *tile = nullptr;
+    /** The tile is a multitile subtile ("id_corner" etc.), which is drawn without seeding. */
+    bool is_subtile = false;
+    bool resolved = false;
+};
+
+/** Cached lookup results for one object id, indexed by subtile + 1 (subtile -1 means none). */
+using tile_lookup_set = std::array<tile_lookup_res, num_multitile_types + 1>;
+
 /** Typedefs */
 struct SDL_Texture_deleter {
     // Operator overload required to leverage unique_ptr API.
@@ -95,6 +112,18 @@ struct SDL_Surface_deleter {
 };
 using SDL_Surface_Ptr = std::unique_ptr<SDL_Surface, SDL_Surface_deleter>;
 
+/**
+ * A single sprite: an area of one of the atlas textures. Drawing many sprites from the
+ * same atlas lets the renderer batch them instead of switching textures for each one.
+ */
+struct texture {
+    /** Not owned, see @ref cata_tiles::atlases. */
+    SDL_Texture *atlas;
+    SDL_Rect srcrect;
+
+    texture( SDL_Texture *const atlas, const SDL_Rect &srcrect ) : atlas( atlas ), srcrect( srcrect ) { }
+};
+
 // Cache of a single tile, used to avoid redrawing what didn't change.
 struct tile_drawing_cache {
 
@@ -341,6 +370,29 @@ class cata_tiles
         bool draw_from_id_string( std::string id, TILE_CATEGORY category,
                                   const std::string &subcategory, tripoint pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /**
+         * Draw an already resolved tile at map position @p pos. @p id and @p category are
+         * only used to seed the sprite variant selection.
+         */
+        bool draw_tile_at_pos( const tile_type &display_tile, const std::string &id,
+                               TILE_CATEGORY category, tripoint pos, int rota, lit_level ll,
+                               bool apply_night_vision_goggles, int &height_3d );
+        /**
+         * Look up @p id, preferring the variant for the current season.
+         * @p id is changed to the seasonal id if that one was found.
+         * @return nullptr if neither is defined in the tileset.
+         */
+        const tile_type *find_tile_with_season( std::string &id ) const;
+        /**
+         * Same lookup as @ref draw_from_id_string does for a tile found directly in the
+         * tileset (including the multitile subtile), but memoized in @p table by the
+         * integer id @p index of the drawn object. Fallbacks (looks like ASCII, unknown)
+         * are not cached, for them the result has a null tile.
+         */
+        const tile_lookup_res &find_tile_cached( std::vector<tile_lookup_set> &table, size_t index,
+                int subtile, const std::string &id );
+        /** Drop all cached lookups, must be called whenever tile_ids or the season change. */
+        void clear_tile_lookup_cache();
         bool draw_sprite_at( const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
                              int x, int y, unsigned int loc_rand, int rota_fg, int rota, lit_level ll,
                              bool apply_night_vision_goggles );
@@ -479,9 +531,23 @@ class cata_tiles
 
         /** Variables */
         SDL_Renderer *renderer;
-        std::vector<SDL_Texture_Ptr> tile_values;
+        /** Owns the textures the sprites in the *tile_values vectors point into. */
+        std::vector<SDL_Texture_Ptr> atlases;
+        std::vector<texture> tile_values;
         std::unordered_map<std::string, tile_type> tile_ids;
 
+        /**
+         * Resolved tiles of the objects drawn on every map square, indexed by their int id
+         * (@ref ter_id, @ref furn_id, @ref trap_id and @ref field_id respectively).
+         * Pointers into @ref tile_ids, so they are cleared together with it.
+         */
+        std::vector<tile_lookup_set> terrain_lookup;
+        std::vector<tile_lookup_set> furniture_lookup;
+        std::vector<tile_lookup_set> trap_lookup;
+        std::vector<tile_lookup_set> field_lookup;
+        /** Season the lookup tables above have been filled for. */
+        season_type tile_lookup_season = SPRING;
+
         int tile_height = 0, tile_width = 0, default_tile_width, default_tile_height;
         // The width and height of the area we can draw in,
         // measured in map coordinates, *not* in pixels.
@@ -532,9 +598,9 @@ class cata_tiles
     private:
         void create_default_item_highlight();
         int last_pos_x, last_pos_y;
-        std::vector<SDL_Texture_Ptr> shadow_tile_values;
-        std::vector<SDL_Texture_Ptr> night_tile_values;
-        std::vector<SDL_Texture_Ptr> overexposed_tile_values;
+        std::vector<texture> shadow_tile_values;
+        std::vector<texture> night_tile_values;
+        std::vector<texture> overexposed_tile_values;
         /**
          * Tracks active night vision goggle status for each draw call.
          * Allows usage of night vision tilesets during sprite rendering.
@@ -13,6 +13,7 @@
 #include "filesystem.h"
 #include "item_search.h"
 #include "rng.h"
+#include "save_writer.h"
 
 #include <algorithm>
 #include <cmath>
@@ -433,6 +434,7 @@ std::istream &safe_getline( std::istream &ins, std::string &str )
 
 bool read_from_file( const std::string &path, const std::function<void( std::istream & )> &reader )
 {
+    save_writer::wait_for( path );
     try {
         std::ifstream fin( path, std::ios::binary );
         if( !fin ) {
@@ -471,6 +473,7 @@ bool read_from_file_optional( const std::string &path,
     // Note: slight race condition here, but we'll ignore it. Worst case: the file
     // exists and got removed before reading it -> reading fails with a message
     // Or file does not exists, than everything works fine because it's optional anyway.
+    save_writer::wait_for( path );
     return file_exist( path ) && read_from_file( path, reader );
 }
 
@@ -54,23 +54,65 @@ typedef struct {
     int BG;
 } pairs;
 
+/**
+ * Cell contents are interned: each distinct UTF-8 string ever written into a cell gets
+ * a small id, which is all the cell stores. Id 0 is the empty string (second cell of a
+ * wide character), single ASCII characters use their own code as id.
+ */
+uint32_t intern_cell_glyph( const std::string &ch );
+const std::string &cell_glyph_string( uint32_t id );
+
 //Individual lines, so that we can track changed lines
 struct cursecell {
-    std::string ch;
+    uint32_t glyph;
     char FG = 0;
     char BG = 0;
 
-    cursecell( std::string ch ) : ch( std::move( ch ) ) { }
-    cursecell() : cursecell( std::string( 1, ' ' ) ) { }
+    cursecell( const std::string &ch ) : glyph( intern_cell_glyph( ch ) ) { }
+    cursecell() : glyph( ' ' ) { }
+
+    const std::string &ch() const {
+        return cell_glyph_string( glyph );
+    }
+    void set_ch( const std::string &ch ) {
+        glyph = intern_cell_glyph( ch );
+    }
+    /** Whether this is the (empty) second cell of a wide character. */
+    bool empty() const {
+        return glyph == 0;
+    }
 
     bool operator==( const cursecell &b ) const {
-        return FG == b.FG && BG == b.BG && ch == b.ch;
+        return FG == b.FG && BG == b.BG && glyph == b.glyph;
     }
 };
 
 struct curseline {
-    bool touched;
+    bool touched = false;
+    /** Cells [dirty_begin, dirty_end) have been changed since the line was last drawn. */
+    int dirty_begin = 0;
+    int dirty_end = 0;
     std::vector<cursecell> chars;
+
+    void touch( int x ) {
+        if( !touched || x < dirty_begin ) {
+            dirty_begin = x;
+        }
+        if( !touched || x >= dirty_end ) {
+            dirty_end = x + 1;
+        }
+        touched = true;
+    }
+    void touch_all() {
+        touched = true;
+        dirty_begin = 0;
+        dirty_end = chars.size();
+    }
+    void untouch() {
+        touched = false;
+        dirty_begin = 0;
+        dirty_end = 0;
+    }
 };
 
 //The curses window struct
@@ -0,0 +1,85 @@
+#pragma once
+#ifndef CREATURE_GRID_H
+#define CREATURE_GRID_H
+
+#include "enums.h"
+#include "game_constants.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Maps the tiles of the reality bubble to the creature on them (an index or a pointer,
+ * whatever the owner uses as handle), so a lookup is a single array read.
+ *
+ * Each z-level is a dense array, allocated when something is first put on that level.
+ * Positions outside of the bubble (creatures about to be despawned, or put there by
+ * mistake) are stored in a hash map instead.
+ */
+template<typename T>
+class creature_grid
+{
+    public:
+        /** @param empty The value of tiles without a creature. */
+        creature_grid( const T &empty ) : empty( empty ) {
+        }
+
+        const T &get( const tripoint &p ) const {
+            if( !inside( p ) ) {
+                const auto iter = outside.find( p );
+                return iter != outside.end() ? iter->second : empty;
+            }
+            const std::vector<T> &level = levels[p.z + OVERMAP_DEPTH];
+            return level.empty() ? empty : level[index( p )];
+        }
+
+        void set( const tripoint &p, const T &value ) {
+            if( !inside( p ) ) {
+                if( value == empty ) {
+                    outside.erase( p );
+                } else {
+                    outside[p] = value;
+                }
+                return;
+            }
+            std::vector<T> &level = levels[p.z + OVERMAP_DEPTH];
+            if( level.empty() ) {
+                if( value == empty ) {
+                    return;
+                }
+                level.assign( size * size, empty );
+            }
+            level[index( p )] = value;
+        }
+
+        void erase( const tripoint &p ) {
+            set( p, empty );
+        }
+
+        /** Empties all tiles, keeps the allocated levels for reuse. */
+        void clear() {
+            for( auto &level : levels ) {
+                std::fill( level.begin(), level.end(), empty );
+            }
+            outside.clear();
+        }
+
+    private:
+        static const int size = MAPSIZE * SEEX;
+
+        static bool inside( const tripoint &p ) {
+            return p.x >= 0 && p.x < size && p.y >= 0 && p.y < size &&
+                   p.z >= -OVERMAP_DEPTH && p.z <= OVERMAP_HEIGHT;
+        }
+        static size_t index( const tripoint &p ) {
+            return p.x + p.y * size;
+        }
+
+        T empty;
+        std::array<std::vector<T>, OVERMAP_LAYERS> levels;
+        std::unordered_map<tripoint, T> outside;
+};
+
+#endif
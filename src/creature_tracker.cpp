@@ -5,10 +5,11 @@
 #include "debug.h"
 #include "mtype.h"
 #include "item.h"
+#include "npc.h"
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
-Creature_tracker::Creature_tracker()
+Creature_tracker::Creature_tracker() : monsters_by_location( -1 ), npcs_by_location( nullptr )
 {
 }
 
@@ -36,12 +37,9 @@ const monster &Creature_tracker::find( int index ) const
 
 int Creature_tracker::mon_at( const tripoint &coords ) const
 {
-    const auto iter = monsters_by_location.find( coords );
-    if( iter != monsters_by_location.end() ) {
-        const int critter_id = iter->second;
-        if( !monsters_list[critter_id]->is_dead() ) {
-            return ( int )critter_id;
-        }
+    const int critter_id = monsters_by_location.get( coords );
+    if( critter_id != -1 && !monsters_list[critter_id]->is_dead() ) {
+        return critter_id;
     }
 
     return -1;
@@ -77,7 +75,7 @@ bool Creature_tracker::add( monster &critter )
         return false;
     }
 
-    monsters_by_location[critter.pos()] = monsters_list.size();
+    monsters_by_location.set( critter.pos(), monsters_list.size() );
     monsters_list.push_back( new monster( critter ) );
     return true;
 }
@@ -114,7 +112,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     if( critter_id >= 0 ) {
         if( &critter == monsters_list[critter_id] ) {
             monsters_by_location.erase( old_pos );
-            monsters_by_location[new_pos] = critter_id;
+            monsters_by_location.set( new_pos, critter_id );
             return true;
         } else {
             const auto &othermon = *monsters_list[critter_id];
@@ -140,12 +138,9 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const tripoint &loc = critter.pos();
-    const auto pos_iter = monsters_by_location.find( loc );
-    if( pos_iter != monsters_by_location.end() ) {
-        const auto &other = find( pos_iter->second );
-        if( &other == &critter ) {
-            monsters_by_location.erase( pos_iter );
-        }
+    const int critter_id = monsters_by_location.get( loc );
+    if( critter_id != -1 && &find( critter_id ) == &critter ) {
+        monsters_by_location.erase( loc );
     }
 }
 
@@ -164,9 +159,10 @@ void Creature_tracker::remove( const int idx )
     monsters_list.erase( monsters_list.begin() + idx );
 
     // Fix indices in monsters_by_location for any zombies that were just moved down 1 place.
-    for( auto &elem : monsters_by_location ) {
-        if( elem.second > ( size_t )idx ) {
-            --elem.second;
+    for( size_t i = idx; i < monsters_list.size(); i++ ) {
+        const tripoint &loc = monsters_list[i]->pos();
+        if( monsters_by_location.get( loc ) == ( int )i + 1 ) {
+            monsters_by_location.set( loc, i );
         }
     }
 }
@@ -185,7 +181,7 @@ void Creature_tracker::rebuild_cache()
     monsters_by_location.clear();
     for( size_t i = 0; i < monsters_list.size(); i++ ) {
         monster &critter = *monsters_list[i];
-        monsters_by_location[critter.pos()] = i;
+        monsters_by_location.set( critter.pos(), i );
     }
 }
 
@@ -215,8 +211,8 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     second.spawn( first.pos() );
     first.spawn( temp );
     if( ok ) {
-        monsters_by_location[first.pos()] = first_mdex;
-        monsters_by_location[second.pos()] = second_mdex;
+        monsters_by_location.set( first.pos(), first_mdex );
+        monsters_by_location.set( second.pos(), second_mdex );
     } else {
         // Try to avoid spamming error messages if something weird happens
         rebuild_cache();
@@ -241,3 +237,30 @@ bool Creature_tracker::kill_marked_for_death()
 
     return monster_is_dead;
 }
+
+npc *Creature_tracker::npc_at( const tripoint &coords ) const
+{
+    npc *const who = npcs_by_location.get( coords );
+    // The position check guards against NPCs moved without going through setpos.
+    if( who != nullptr && !who->is_dead() && who->pos() == coords ) {
+        return who;
+    }
+    return nullptr;
+}
+
+void Creature_tracker::rebuild_npc_cache( const std::vector<npc *> &active_npcs )
+{
+    npcs_by_location.clear();
+    for( npc *const who : active_npcs ) {
+        npcs_by_location.set( who->pos(), who );
+    }
+}
+
+void Creature_tracker::update_npc_pos( npc &who, const tripoint &new_pos )
+{
+    // Another NPC may have moved onto the old position already (e.g. when swapping places).
+    if( npcs_by_location.get( who.pos() ) == &who ) {
+        npcs_by_location.erase( who.pos() );
+    }
+    npcs_by_location.set( new_pos, &who );
+}
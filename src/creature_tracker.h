@@ -2,11 +2,12 @@
 #ifndef CREATURE_TRACKER_H
 #define CREATURE_TRACKER_H
 
+#include "creature_grid.h"
 #include "enums.h"
 #include <vector>
-#include <unordered_map>
 
 class monster;
+class npc;
 
 class Creature_tracker
 {
@@ -34,9 +35,18 @@ class Creature_tracker
         /** Kills 0 hp monsters. Returns if it killed any. */
         bool kill_marked_for_death();
 
+        /** Returns the living NPC at the given tripoint, if it is one of the tracked ones. */
+        npc *npc_at( const tripoint &coords ) const;
+        /** Tracks exactly the given NPCs, on their current positions. */
+        void rebuild_npc_cache( const std::vector<npc *> &active_npcs );
+        /** Moves a tracked NPC to the given point, must be called before its position changes. */
+        void update_npc_pos( npc &who, const tripoint &new_pos );
+
     private:
         std::vector<monster *> monsters_list;
-        std::unordered_map<tripoint, size_t> monsters_by_location;
+        /** Index into @ref monsters_list of the monster on each tile, -1 if there is none. */
+        creature_grid<int> monsters_by_location;
+        creature_grid<npc *> npcs_by_location;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
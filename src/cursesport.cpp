@@ -6,6 +6,7 @@
 #include "animation.h"
 
 #include <cstring> // strlen
+#include <unordered_map>
 
 /**
  * Whoever cares, btw. not my base design, but this is how it works:
@@ -23,6 +24,9 @@
  * width. If it's two cells width, the next cell in the line must be completely
  * empty (the string must not contain anything). Also the last cell of a line
  * must not contain a two cell width string.
+ * The cells only store an id of that string (see intern_cell_glyph), so printing
+ * does not allocate. Each line tracks the range of cells changed since it was
+ * last drawn, so only those need to be redrawn.
  */
 
 //***********************************
@@ -37,6 +41,49 @@ int echoOn;     //1 = getnstr shows input, 0 = doesn't show. needed for echo()-n
 // allow extra logic for framebuffer clears
 extern void handle_additional_window_clear( WINDOW* win );
 
+struct cell_glyph_table {
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> ids;
+
+    cell_glyph_table() {
+        // The ids of the empty string and the ASCII characters are fixed, see intern_cell_glyph
+        for( int c = 0; c < 128; c++ ) {
+            strings.emplace_back( c == 0 ? 0 : 1, static_cast<char>( c ) );
+            ids[strings.back()] = c;
+        }
+    }
+};
+
+static cell_glyph_table &cell_glyphs()
+{
+    static cell_glyph_table table;
+    return table;
+}
+
+uint32_t intern_cell_glyph( const std::string &ch )
+{
+    if( ch.empty() ) {
+        return 0;
+    }
+    if( ch.length() == 1 && static_cast<unsigned char>( ch[0] ) < 128 ) {
+        return static_cast<unsigned char>( ch[0] );
+    }
+    cell_glyph_table &table = cell_glyphs();
+    const auto iter = table.ids.find( ch );
+    if( iter != table.ids.end() ) {
+        return iter->second;
+    }
+    const uint32_t id = table.strings.size();
+    table.strings.push_back( ch );
+    table.ids.emplace( ch, id );
+    return id;
+}
+
+const std::string &cell_glyph_string( const uint32_t id )
+{
+    return cell_glyphs().strings[id];
+}
+
 //***********************************
 //Pseudo-Curses Functions           *
 //***********************************
@@ -83,7 +130,7 @@ WINDOW *newwin(int nlines, int ncols, int begin_y, int begin_x)
 
     for (int j = 0; j < nlines; j++) {
         newwindow->line[j].chars.resize(ncols);
-        newwindow->line[j].touched = true; //Touch them all !?
+        newwindow->line[j].touch_all(); //Touch them all !?
     }
     return newwindow;
 }
@@ -109,11 +156,11 @@ inline int newline(WINDOW *win)
 }
 
 // move the cursor a single cell, jumps to the next line if the
-// end of a line has been reached, also sets the touched flag.
+// end of a line has been reached, also marks the cell as touched.
 inline void addedchar(WINDOW *win)
 {
+    win->line[win->cursory].touch( win->cursorx );
     win->cursorx++;
-    win->line[win->cursory].touched = true;
     if (win->cursorx >= win->width) {
         newline(win);
     }
@@ -355,10 +402,13 @@ inline int printstring(WINDOW *win, const std::string &text)
     if( win->cursory >= win->height || win->cursorx >= win->width ) {
         return 0;
     }
-    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].ch.empty() ) {
+    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].empty() ) {
         // start inside a wide character, erase it for good
-        win->line[win->cursory].chars[win->cursorx - 1].ch.assign(" ");
+        win->line[win->cursory].chars[win->cursorx - 1].glyph = ' ';
+        win->line[win->cursory].touch( win->cursorx - 1 );
     }
+    // reused between calls, so extracting a character does not allocate
+    static std::string cell_text;
     while( len > 0 ) {
         if( *fmt == '\n' ) {
             if( newline(win) == 0 ) {
@@ -372,7 +422,8 @@ inline int printstring(WINDOW *win, const std::string &text)
         if( curcell == nullptr ) {
             return 0;
         }
-        const int dlen = fill(fmt, len, curcell->ch);
+        const int dlen = fill(fmt, len, cell_text);
+        curcell->set_ch( cell_text );
         if( dlen >= 1 ) {
             curcell->FG = win->FG;
             curcell->BG = win->BG;
@@ -382,8 +433,9 @@ inline int printstring(WINDOW *win, const std::string &text)
             // a wide character was converted to a narrow character leaving a null in the
             // following cell ~> clear it
             cursecell *seccell = cur_cell( win );
-            if (seccell && seccell->ch.empty()) {
-                seccell->ch.assign(' ', 1);
+            if (seccell && seccell->empty()) {
+                seccell->glyph = ' ';
+                win->line[win->cursory].touch( win->cursorx );
             }
         } else if( dlen == 2 ) {
             // the second cell, per definition must be empty
@@ -392,25 +444,26 @@ inline int printstring(WINDOW *win, const std::string &text)
                 // the previous cell was valid, this one is outside of the window
                 // --> the previous was the last cell of the last line
                 // --> there should not be a two-cell width character in the last cell
-                curcell->ch.assign(' ', 1);
+                curcell->glyph = ' ';
                 return 0;
             }
             seccell->FG = win->FG;
             seccell->BG = win->BG;
-            seccell->ch.erase();
+            seccell->glyph = 0;
             addedchar( win );
             // Have just written a wide-character into the last cell, it would not
             // display correctly if it was the last *cell* of a line
             if( win->cursorx == 1 ) {
                 // So make that last cell a space, move the width
                 // character in the first cell of the line
-                seccell->ch = curcell->ch;
-                curcell->ch.assign(1, ' ');
+                seccell->glyph = curcell->glyph;
+                curcell->glyph = ' ';
                 // and make the second cell on the new line empty.
                 addedchar( win );
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
-                    thicell->ch.erase();
+                    thicell->glyph = 0;
+                    win->line[win->cursory].touch( win->cursorx );
                 }
             }
         }
@@ -484,7 +537,7 @@ int werase(WINDOW *win)
 
     for (int j = 0; j < win->height; j++) {
         win->line[j].chars.assign(win->width, cursecell());
-        win->line[j].touched = true;
+        win->line[j].touch_all();
     }
     win->draw = true;
     wmove(win, 0, 0);
@@ -568,7 +621,7 @@ int clearok(WINDOW *win)
     }
 
     for (int i = 0; i < win->y && i < stdscr->height; i++) {
-        stdscr->line[i].touched = true;
+        stdscr->line[i].touch_all();
     }
     return 1;
 }
@@ -1767,7 +1767,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                         for( int y = 0; y < 2; y++ ) {
                             // Apply previewed mapgen to map. Since this is a function for testing, we try avoid triggering
                             // functions that would alter the results
-                            submap *destsm = g->m.get_submap_at_grid( target_sub.x + x, target_sub.y + y, target.z );
+                            submap *destsm = g->m.unshare_submap_at_grid( tripoint( target_sub.x + x, target_sub.y + y, target.z ) );
                             submap *srcsm = tmpmap.get_submap_at_grid( x, y, target.z );
                             destsm->is_uniform = false;
                             srcsm->is_uniform = false;
@@ -1798,24 +1798,16 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                                 spawns_todo++;
                             }
 
-                            for( int sx = 0; sx < 12; sx++ ) {  // copy fields
-                                for( int sy = 0; sy < 12; sy++ ) {
-                                    destsm->fld[sx][sy] = srcsm->fld[sx][sy];
-                                }
-                            }
+                            destsm->fld = srcsm->fld; // copy fields
                             destsm->field_count = srcsm->field_count; // and count
 
                             std::memcpy( destsm->ter, srcsm->ter, sizeof( srcsm->ter ) ); // terrain
                             std::memcpy( destsm->frn, srcsm->frn, sizeof( srcsm->frn ) ); // furniture
                             std::memcpy( destsm->trp, srcsm->trp, sizeof( srcsm->trp ) ); // traps
-                            std::memcpy( destsm->rad, srcsm->rad, sizeof( srcsm->rad ) ); // radiation
+                            destsm->rad = srcsm->rad; // radiation
                             std::memcpy( destsm->lum, srcsm->lum, sizeof( srcsm->lum ) ); // emissive items
-                            for( int x = 0; x < SEEX; ++x ) {
-                                for( int y = 0; y < SEEY; ++y ) {
-                                    destsm->itm[x][y].swap( srcsm->itm[x][y] );
-                                    destsm->cosmetics[x][y].swap( srcsm->cosmetics[x][y] );
-                                }
-                            }
+                            std::swap( destsm->itm, srcsm->itm );
+                            std::swap( destsm->cosmetics, srcsm->cosmetics );
 
                             // various misc variables
                             destsm->active_items = srcsm->active_items;
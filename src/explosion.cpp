@@ -53,6 +53,63 @@ shrapnel_data load_shrapnel_data( JsonObject &jo )
     return ret;
 }
 
+namespace
+{
+
+/**
+ * The state of each tile a blast can reach: the best known distance from the center and
+ * whether the tile was processed, stored in dense arrays on a box around the center.
+ */
+class blast_grid
+{
+    public:
+        blast_grid( const tripoint &min, const tripoint &max ) : min( min ),
+            size_x( max.x - min.x + 1 ), size_y( max.y - min.y + 1 ), size_z( max.z - min.z + 1 ),
+            dist( size_x * size_y * size_z, unreached ), closed( dist.size(), false ) {
+        }
+
+        /** Distance to the tile, @ref unreached if nothing was pushed to it yet. */
+        float &dist_at( const tripoint &p ) {
+            return dist[index( p )];
+        }
+        std::vector<bool>::reference closed_at( const tripoint &p ) {
+            return closed[index( p )];
+        }
+
+        /** Calls @p func( tile, distance ) for each closed tile, ordered like std::set<tripoint>. */
+        template<typename Func>
+        void for_each_closed( Func func ) const {
+            for( int x = 0; x < size_x; x++ ) {
+                for( int y = 0; y < size_y; y++ ) {
+                    for( int z = 0; z < size_z; z++ ) {
+                        const size_t i = x + ( y + z * size_y ) * size_x;
+                        if( closed[i] ) {
+                            func( tripoint( min.x + x, min.y + y, min.z + z ), dist[i] );
+                        }
+                    }
+                }
+            }
+        }
+
+        static constexpr float unreached = -1.0f;
+
+    private:
+        size_t index( const tripoint &p ) const {
+            return ( p.x - min.x ) + ( ( p.y - min.y ) + ( p.z - min.z ) * size_y ) * size_x;
+        }
+
+        tripoint min;
+        int size_x;
+        int size_y;
+        int size_z;
+        std::vector<float> dist;
+        std::vector<bool> closed;
+};
+
+constexpr float blast_grid::unreached;
+
+} // namespace
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
 void game::do_blast( const tripoint &p, const float power,
                      const float distance_factor, const bool fire )
@@ -69,14 +126,29 @@ void game::do_blast( const tripoint &p, const float power,
     static const int z_offset[10] = {  0, 0,  0, 0,  0,  0,  0, 0, 1, -1 };
     const size_t max_index = m.has_zlevels() ? 10 : 8;
 
+    // Only tiles closer than this propagate the blast (their force is above 1), each step
+    // adds at least one tile (three for a z-level) to the distance.
+    const int map_size = m.getmapsize() * SEEX;
+    const float reach = power > 1.0f ? std::log( power ) / -std::log( distance_factor ) : 0.0f;
+    const int radius = int( std::min( reach, float( map_size ) ) ) + 2;
+    const int z_radius = m.has_zlevels() ? int( std::min( reach, float( map_size ) ) / ( tile_dist + zlev_dist ) ) + 2 : 0;
+    // Tiles outside of the map are impassable, so the blast reaches at most one beyond it.
+    const tripoint box_min( std::max( p.x - radius, std::min( -1, p.x - 1 ) ),
+                            std::max( p.y - radius, std::min( -1, p.y - 1 ) ),
+                            std::max( p.z - z_radius, std::min( -OVERMAP_DEPTH - 1, p.z - 1 ) ) );
+    const tripoint box_max( std::min( p.x + radius, std::max( map_size, p.x + 1 ) ),
+                            std::min( p.y + radius, std::max( map_size, p.y + 1 ) ),
+                            std::min( p.z + z_radius, std::max( OVERMAP_HEIGHT + 1, p.z + 1 ) ) );
+    blast_grid grid( box_min, box_max );
+
     m.bash( p, fire ? power : ( 2 * power ), true, false, false );
 
+    // The comparator looks only at the whole part of the distance, tiles of the same
+    // whole distance come out in the order of the heap.
     std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp >
     open;
-    std::set<tripoint> closed;
-    std::map<tripoint, float> dist_map;
     open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
+    grid.dist_at( p ) = 0.0f;
     // Find all points to blast
     while( !open.empty() ) {
         // Add some random factor to effective distance to make it look cooler
@@ -84,11 +156,11 @@ void game::do_blast( const tripoint &p, const float power,
         const tripoint pt = open.top().second;
         open.pop();
 
-        if( closed.count( pt ) != 0 ) {
+        if( grid.closed_at( pt ) ) {
             continue;
         }
 
-        closed.insert( pt );
+        grid.closed_at( pt ) = true;
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -102,10 +174,11 @@ void game::do_blast( const tripoint &p, const float power,
 
         // Those will be used for making "shaped charges"
         // Don't check up/down (for now) - this will make 2D/3D balancing easier
+        // Fiery blasts don't get the bonus, so they don't need to count.
         int empty_neighbors = 0;
-        for( size_t i = 0; i < 8; i++ ) {
+        for( size_t i = 0; i < 8 && !fire; i++ ) {
             tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
-            if( closed.count( dest ) == 0 && m.valid_move( pt, dest, false, true ) ) {
+            if( !grid.closed_at( dest ) && m.valid_move( pt, dest, false, true ) ) {
                 empty_neighbors++;
             }
         }
@@ -114,7 +187,7 @@ void game::do_blast( const tripoint &p, const float power,
         // Iterate over all neighbors. Bash all of them, propagate to some
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
-            if( closed.count( dest ) != 0 ) {
+            if( grid.closed_at( dest ) ) {
                 continue;
             }
 
@@ -145,21 +218,30 @@ void game::do_blast( const tripoint &p, const float power,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            float &dest_dist = grid.dist_at( dest );
+            if( dest_dist == blast_grid::unreached || dest_dist > next_dist ) {
                 open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                dest_dist = next_dist;
             }
         }
     }
 
+    // Everything below walks the blasted tiles in a fixed order, which also keeps the
+    // random numbers used for them the same.
+    std::vector<std::pair<tripoint, float>> blasted;
+    grid.for_each_closed( [&blasted, power, distance_factor]( const tripoint & pt, const float dist ) {
+        blasted.emplace_back( pt, power * std::pow( distance_factor, dist ) );
+    } );
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( auto &pt : closed ) {
+    for( const auto &elem : blasted ) {
+        const tripoint &pt = elem.first;
         if( m.impassable( pt ) ) {
             continue;
         }
 
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = elem.second;
         nc_color col = c_red;
         if( force < 10 ) {
             col = c_white;
@@ -172,8 +254,9 @@ void game::do_blast( const tripoint &p, const float power,
 
     draw_custom_explosion( u.pos(), explosion_colors );
 
-    for( const tripoint &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+    for( const auto &elem : blasted ) {
+        const tripoint &pt = elem.first;
+        const float force = elem.second;
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -735,7 +735,11 @@ bool map::process_fields_in_submap( submap *const current_submap,
             const tripoint &p = thep;
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
-            field &curfield = current_submap->fld[locx][locy];
+            field *const fields = current_submap->fld.find( locx, locy );
+            if( fields == nullptr ) {
+                continue;
+            }
+            field &curfield = *fields;
             for( auto it = curfield.begin(); it != curfield.end();) {
                 //Iterating through all field effects in the submap's field.
                 field_entry * cur = &it->second;
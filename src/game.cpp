@@ -78,6 +78,7 @@
 #include "item_location.h"
 #include "weather.h"
 #include "faction.h"
+#include "turn_profiler.h"
 #include "enums.h"
 #include "live_view.h"
 #include "recipe_dictionary.h"
@@ -91,6 +92,7 @@
 #include "safemode_ui.h"
 #include "game_constants.h"
 #include "string_input_popup.h"
+#include "save_writer.h"
 
 #include <map>
 #include <set>
@@ -769,6 +771,7 @@ void game::setup()
     clear_zombies();
     coming_to_stairs.clear();
     active_npc.clear();
+    critter_tracker->rebuild_npc_cache( active_npc );
     mission_npc.clear();
     factions.clear();
     mission::clear_all();
@@ -808,7 +811,7 @@ bool game::start_game(std::string worldname)
         gamemode.reset( new special_game() );
     }
 
-    seed = rand();
+    seed = rng_bits();
     new_game = true;
     start_calendar();
     nextweather = calendar::turn;
@@ -972,6 +975,8 @@ void game::load_npcs()
     for( auto npc : just_added ) {
         npc->on_load();
     }
+    // Also catches the NPCs that were shifted or unloaded before this.
+    critter_tracker->rebuild_npc_cache( active_npc );
 
     npcs_dirty = false;
 }
@@ -983,6 +988,7 @@ void game::unload_npcs()
     }
 
     active_npc.clear();
+    critter_tracker->rebuild_npc_cache( active_npc );
 }
 
 void game::reload_npcs()
@@ -1426,18 +1432,29 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // There is no game mode when the turn is run headless, see test_mode.
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn.increment();
     }
 
     if( npcs_dirty ) {
+        turn_profiler::scoped_phase phase( "load_npcs" );
         load_npcs();
     }
 
-    process_events();
-    mission::process_all();
+    {
+        turn_profiler::scoped_phase phase( "process_events" );
+        process_events();
+    }
+    {
+        turn_profiler::scoped_phase phase( "mission::process_all" );
+        mission::process_all();
+    }
     if (calendar::turn.hours() == 0 && calendar::turn.minutes() == 0 &&
         calendar::turn.seconds() == 0) { // Midnight!
+        turn_profiler::scoped_phase phase( "process_mongroups" );
         overmap_buffer.process_mongroups();
         lua_callback("on_day_passed");
     }
@@ -1449,23 +1466,33 @@ bool game::do_turn()
 
     // Move hordes every 5 min
     if( calendar::once_every(MINUTES(5)) ) {
+        turn_profiler::scoped_phase phase( "move_hordes" );
         overmap_buffer.move_hordes();
         // Hordes that reached the reality bubble need to spawn,
         // make them spawn in invisible areas only.
         m.spawn_monsters( false );
     }
 
-    u.update_body();
+    {
+        turn_profiler::scoped_phase phase( "u.update_body" );
+        u.update_body();
+    }
 
     // Auto-save if autosave is enabled
     if (get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every(get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state()) {
+        turn_profiler::scoped_phase phase( "autosave" );
         autosave();
     }
+    // Failures of the background writes of the last save
+    save_writer::report_errors();
 
-    update_weather();
-    reset_light_level();
+    {
+        turn_profiler::scoped_phase phase( "update_weather" );
+        update_weather();
+        reset_light_level();
+    }
 
     // The following happens when we stay still; 10/40 minutes overdue for spawn
     if ((!u.has_trait( trait_INCONSPICUOUS ) && calendar::turn > nextspawn + 100) ||
@@ -1479,7 +1506,10 @@ bool game::do_turn()
     // Process sound events into sound markers for display to the player.
     sounds::process_sound_markers( &u );
 
-    if (!u.in_sleep_state()) {
+    if( test_mode ) {
+        // Headless (tests and benchmarks): nobody is there to give input, the player just waits.
+        u.moves = std::min( u.moves, 0 );
+    } else if (!u.in_sleep_state()) {
         if (u.moves > 0 || uquit == QUIT_WATCH) {
             while (u.moves > 0 || uquit == QUIT_WATCH) {
                 cleanup_dead();
@@ -1522,81 +1552,136 @@ bool game::do_turn()
         calc_driving_offset(veh);
     }
 
+    // Parts of the world step that only matter to other creatures (scent, their vision caches)
+    // are done once per minute instead of every turn while nobody is around.
+    const bool coarse_step = is_quiet_turn() && !calendar::once_every( MINUTES( 1 ) );
+
     // No-scent debug mutation has to be processed here or else it takes time to start working
     if( !u.has_active_bionic( "bio_scent_mask" ) &&
         !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
         scent.set( u.pos(), u.scent );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
+    if( !coarse_step ) {
+        turn_profiler::scoped_phase phase( "scent.update" );
+        scent.update( u.pos(), m );
+    }
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        // We need floor cache before checking falling 'n stuff
+        turn_profiler::scoped_phase phase( "m.build_floor_caches" );
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    m.vehmove();
+    {
+        turn_profiler::scoped_phase phase( "m.vehmove" );
+        m.process_falling();
+        m.vehmove();
+    }
 
     // Process power and fuel consumption for all vehicles, including off-map ones.
     // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy(sm_loc.x, sm_loc.y);
-        point in_reality = m.getlocal(sm_topleft);
+    {
+        turn_profiler::scoped_phase phase( "vehicle idle" );
+        for( auto &elem : MAPBUFFER ) {
+            tripoint sm_loc = elem.first;
+            point sm_topleft = sm_to_ms_copy(sm_loc.x, sm_loc.y);
+            point in_reality = m.getlocal(sm_topleft);
 
-        submap *sm = elem.second;
+            submap *sm = elem.second;
 
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->power_parts();
-            veh->idle( in_bubble_z && m.inbounds(in_reality.x, in_reality.y) );
+            const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
+            for( auto &veh : sm->vehicles ) {
+                veh->power_parts();
+                veh->idle( in_bubble_z && m.inbounds(in_reality.x, in_reality.y) );
+            }
         }
     }
-    m.process_fields();
-    m.process_active_items();
+    {
+        turn_profiler::scoped_phase phase( "m.process_fields" );
+        m.process_fields();
+    }
+    {
+        turn_profiler::scoped_phase phase( "m.process_active_items" );
+        m.process_active_items();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
-    update_stair_monsters();
-    u.process_turn();
-    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    {
+        // Apply sounds from previous turn to monster and NPC AI.
+        turn_profiler::scoped_phase phase( "sounds::process_sounds" );
+        sounds::process_sounds();
+    }
+    // Something may have spawned a monster since the check above.
+    if( !coarse_step || !is_quiet_turn() ) {
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        turn_profiler::scoped_phase phase( "m.build_map_cache" );
+        m.build_map_cache( get_levz(), true );
+    }
+    {
+        turn_profiler::scoped_phase phase( "monmove" );
+        monmove();
+        update_stair_monsters();
+    }
+    {
+        turn_profiler::scoped_phase phase( "u.process_turn" );
+        u.process_turn();
+    }
+    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) && !test_mode ) {
         draw();
         refresh_display();
     }
-    u.process_active_items();
+    {
+        turn_profiler::scoped_phase phase( "u.process_active_items" );
+        u.process_active_items();
+    }
 
     if (get_levz() >= 0 && !u.is_underwater()) {
         weather_data(weather).effect();
     }
 
-    if( u.has_effect( effect_sleep) && calendar::once_every(MINUTES(30)) ) {
+    if( u.has_effect( effect_sleep) && calendar::once_every(MINUTES(30)) && !test_mode ) {
         draw();
         refresh();
         refresh_display();
     }
 
-    u.update_bodytemp();
-    u.update_body_wetness( *weather_precise );
-    u.apply_wetness_morale( temperature );
-    rustCheck();
+    {
+        turn_profiler::scoped_phase phase( "u.update_bodytemp" );
+        u.update_bodytemp();
+        u.update_body_wetness( *weather_precise );
+        u.apply_wetness_morale( temperature );
+        rustCheck();
 
-    if( calendar::once_every( MINUTES( 1 ) ) ) {
-        u.update_morale();
-    }
+        if( calendar::once_every( MINUTES( 1 ) ) ) {
+            u.update_morale();
+        }
 
-    if( calendar::once_every( SECONDS( 90 ) ) ) {
-        u.check_and_recover_morale();
+        if( calendar::once_every( SECONDS( 90 ) ) ) {
+            u.check_and_recover_morale();
+        }
     }
 
     sfx::remove_hearing_loss();
     sfx::do_danger_music();
     sfx::do_fatigue();
 
+    // The time spent waiting for input is deliberately not part of any phase.
+    turn_profiler::end_turn();
+    return false;
+}
+
+bool game::is_quiet_turn() const
+{
     return false;
+    // A monster or NPC entering the bubble (spawned, moved in by a horde or loaded) ends
+    // the quiet period on the turn it appears, before it acts.
+    if( num_zombies() > 0 || !active_npc.empty() ) {
+        return false;
+    }
+    return u.has_effect( effect_sleep ) || u.has_activity( activity_id( "ACT_WAIT" ) ) ||
+           u.has_activity( activity_id( "ACT_WAIT_WEATHER" ) );
 }
 
 void game::set_driving_view_offset(const point &p)
@@ -1775,6 +1860,11 @@ unsigned int game::get_seed() const
     return seed;
 }
 
+void game::set_seed( const unsigned int new_seed )
+{
+    seed = new_seed;
+}
+
 void game::set_npcs_dirty()
 {
     npcs_dirty = true;
@@ -1787,6 +1877,7 @@ void game::set_critter_died()
 
 void game::update_weather()
 {
+    rng_stream_scope weather_rng( rng_stream::weather );
     if( weather == WEATHER_NULL || calendar::turn >= nextweather ) {
         const weather_generator &weather_gen = get_cur_weather_gen();
         w_point &w = *weather_precise;
@@ -3351,7 +3442,8 @@ bool game::handle_action()
 
         case ACTION_SAVE:
             if (query_yn(_("Save and quit?"))) {
-                if(save()) {
+                // Don't quit before everything is on the disk.
+                if( save() && save_writer::wait() ) {
                     u.moves = 0;
                     uquit = QUIT_SAVED;
                 }
@@ -3630,6 +3722,9 @@ void game::move_save_to_graveyard()
     const std::string &graveyard_dir = FILENAMES["graveyarddir"];
     const std::string &prefix        = base64_encode(u.name) + ".";
 
+    // The overmap views of the player may still be written.
+    save_writer::wait();
+
     if (!assure_dir_exist(graveyard_dir)) {
         debugmsg("could not create graveyard path '%s'", graveyard_dir.c_str());
     }
@@ -3946,6 +4041,8 @@ static bool isForbidden(std::string candidate)
 // If it's false, just avoid deleting the two config files and the directory itself.
 void game::delete_world(std::string worldname, bool delete_folder)
 {
+    // Pending writes would recreate the files.
+    save_writer::wait();
     std::string worldpath = world_generator->all_worlds[worldname]->world_path;
     std::set<std::string> directory_paths;
 
@@ -4128,6 +4225,7 @@ void game::debug()
                        _( "Draw benchmark (5 seconds)" ),    // 31
                        _( "Teleport - Adjacent overmap" ),   // 32
                        _( "Quit to Main Menu" ),    // 33
+                       _( "Turn profiler..." ),     // 34
                        _( "Cancel" ),
                        NULL );
     int veh_num;
@@ -4491,6 +4589,28 @@ void game::debug()
                 uquit = QUIT_NOSAVED;
             }
             break;
+        case 34: {
+            const int choice = menu( true, _( "Turn profiler" ),
+                                     turn_profiler::enabled() ? _( "Disable profiling" ) : _( "Enable profiling" ),
+                                     turn_profiler::tracing() ? _( "Stop recording trace" ) : _( "Record trace" ),
+                                     _( "Show per-phase times" ),
+                                     _( "Export CSV and Chrome trace" ),
+                                     _( "Reset" ),
+                                     _( "Cancel" ),
+                                     NULL );
+            if( choice == 1 ) {
+                turn_profiler::set_enabled( !turn_profiler::enabled() );
+            } else if( choice == 2 ) {
+                turn_profiler::set_tracing( !turn_profiler::tracing() );
+            } else if( choice == 3 ) {
+                turn_profiler::show_overlay();
+            } else if( choice == 4 ) {
+                turn_profiler::export_files();
+            } else if( choice == 5 ) {
+                turn_profiler::reset();
+            }
+        }
+        break;
     }
     erase();
     refresh_all();
@@ -5984,6 +6104,7 @@ void game::cleanup_dead()
                 it++;
             }
         }
+        critter_tracker->rebuild_npc_cache( active_npc );
     }
 
     critter_died = false;
@@ -5991,94 +6112,98 @@ void game::cleanup_dead()
 
 void game::monmove()
 {
+    rng_stream_scope ai_rng( rng_stream::ai );
     cleanup_dead();
 
     // Make sure these don't match the first time around.
     tripoint cached_lev = m.get_abs_sub() + tripoint( 1, 0, 0 );
 
-    mfactions monster_factions;
-    const auto &playerfaction = mfaction_str_id( "player" );
-    for (size_t i = 0; i < num_zombies(); i++) {
-        // The first time through, and any time the map has been shifted,
-        // recalculate monster factions.
-        if( cached_lev != m.get_abs_sub() ) {
-            // monster::plan() needs to know about all monsters on the same team as the monster.
-            monster_factions.clear();
-            for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
-                monster &critter = zombie( i );
-                if( critter.friendly == 0 ) {
-                    // Only 1 faction per mon at the moment.
-                    monster_factions[ critter.faction ].insert( i );
-                } else {
-                    monster_factions[ playerfaction ].insert( i );
+    {
+        turn_profiler::scoped_phase phase( "monsters" );
+        mfactions monster_factions;
+        const auto &playerfaction = mfaction_str_id( "player" );
+        for (size_t i = 0; i < num_zombies(); i++) {
+            // The first time through, and any time the map has been shifted,
+            // recalculate monster factions.
+            if( cached_lev != m.get_abs_sub() ) {
+                // monster::plan() needs to know about all monsters on the same team as the monster.
+                monster_factions.clear();
+                for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
+                    monster &critter = zombie( i );
+                    if( critter.friendly == 0 ) {
+                        // Only 1 faction per mon at the moment.
+                        monster_factions[ critter.faction ].insert( i );
+                    } else {
+                        monster_factions[ playerfaction ].insert( i );
+                    }
                 }
-            }
-            cached_lev = m.get_abs_sub();
-        }
-
-        monster &critter = critter_tracker->find(i);
-        while (!critter.is_dead() && !critter.can_move_to(critter.pos())) {
-            // If we can't move to our current position, assign us to a new one
-                dbg(D_ERROR) << "game:monmove: " << critter.name().c_str()
-                             << " can't move to its location! (" << critter.posx()
-                             << ":" << critter.posy() << ":" << critter.posz() << "), "
-                             << m.tername(critter.posx(), critter.posy()).c_str();
-                add_msg( m_debug, "%s can't move to its location! (%d,%d,%d), %s", critter.name().c_str(),
-                         critter.posx(), critter.posy(), critter.posz(), m.tername(critter.pos()).c_str());
-            bool okay = false;
-            int xdir = rng(1, 2) * 2 - 3, ydir = rng(1, 2) * 2 - 3; // -1 or 1
-            int startx = critter.posx() - 3 * xdir, endx = critter.posx() + 3 * xdir;
-            int starty = critter.posy() - 3 * ydir, endy = critter.posy() + 3 * ydir;
-            int z = critter.posz();
-            for (int x = startx; x != endx && !okay; x += xdir) {
-                for (int y = starty; y != endy && !okay; y += ydir) {
-                    tripoint dest( x, y, z );
-                    if (critter.can_move_to( dest ) && is_empty( dest )) {
-                        critter.setpos( dest );
-                        okay = true;
+                cached_lev = m.get_abs_sub();
+            }
+
+            monster &critter = critter_tracker->find(i);
+            while (!critter.is_dead() && !critter.can_move_to(critter.pos())) {
+                // If we can't move to our current position, assign us to a new one
+                    dbg(D_ERROR) << "game:monmove: " << critter.name().c_str()
+                                 << " can't move to its location! (" << critter.posx()
+                                 << ":" << critter.posy() << ":" << critter.posz() << "), "
+                                 << m.tername(critter.posx(), critter.posy()).c_str();
+                    add_msg( m_debug, "%s can't move to its location! (%d,%d,%d), %s", critter.name().c_str(),
+                             critter.posx(), critter.posy(), critter.posz(), m.tername(critter.pos()).c_str());
+                bool okay = false;
+                int xdir = rng(1, 2) * 2 - 3, ydir = rng(1, 2) * 2 - 3; // -1 or 1
+                int startx = critter.posx() - 3 * xdir, endx = critter.posx() + 3 * xdir;
+                int starty = critter.posy() - 3 * ydir, endy = critter.posy() + 3 * ydir;
+                int z = critter.posz();
+                for (int x = startx; x != endx && !okay; x += xdir) {
+                    for (int y = starty; y != endy && !okay; y += ydir) {
+                        tripoint dest( x, y, z );
+                        if (critter.can_move_to( dest ) && is_empty( dest )) {
+                            critter.setpos( dest );
+                            okay = true;
+                        }
                     }
                 }
+                if (!okay) {
+                    // die of "natural" cause (overpopulation is natural)
+                    critter.die( nullptr );
+                }
             }
-            if (!okay) {
-                // die of "natural" cause (overpopulation is natural)
-                critter.die( nullptr );
-            }
-        }
 
-        if (!critter.is_dead()) {
-            critter.process_turn();
-        }
+            if (!critter.is_dead()) {
+                critter.process_turn();
+            }
 
-        m.creature_in_field( critter );
+            m.creature_in_field( critter );
 
-        while (critter.moves > 0 && !critter.is_dead()) {
-            critter.made_footstep = false;
-            // Controlled critters don't make their own plans
-            if (!critter.has_effect( effect_controlled)) {
-                // Formulate a path to follow
-                critter.plan( monster_factions );
+            while (critter.moves > 0 && !critter.is_dead()) {
+                critter.made_footstep = false;
+                // Controlled critters don't make their own plans
+                if (!critter.has_effect( effect_controlled)) {
+                    // Formulate a path to follow
+                    critter.plan( monster_factions );
+                }
+                critter.move(); // Move one square, possibly hit u
+                critter.process_triggers();
+                m.creature_in_field( critter );
+            }
+
+            if (!critter.is_dead() &&
+                u.has_active_bionic("bio_alarm") &&
+                u.power_level >= 25 &&
+                rl_dist( u.pos(), critter.pos() ) <= 5 &&
+                !critter.is_hallucination()) {
+                    u.charge_power(-25);
+                    add_msg(m_warning, _("Your motion alarm goes off!"));
+                    cancel_activity_query(_("Your motion alarm goes off!"));
+                    if (u.in_sleep_state()) {
+                        u.wake_up();
+                    }
             }
-            critter.move(); // Move one square, possibly hit u
-            critter.process_triggers();
-            m.creature_in_field( critter );
         }
 
-        if (!critter.is_dead() &&
-            u.has_active_bionic("bio_alarm") &&
-            u.power_level >= 25 &&
-            rl_dist( u.pos(), critter.pos() ) <= 5 &&
-            !critter.is_hallucination()) {
-                u.charge_power(-25);
-                add_msg(m_warning, _("Your motion alarm goes off!"));
-                cancel_activity_query(_("Your motion alarm goes off!"));
-                if (u.in_sleep_state()) {
-                    u.wake_up();
-                }
-        }
+        cleanup_dead();
     }
 
-    cleanup_dead();
-
     // The remaining monsters are all alive, but may be outside of the reality bubble.
     // If so, despawn them. This is not the same as dying, they will be stored for later and the
     // monster::die function is not called.
@@ -6095,6 +6220,7 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    turn_profiler::scoped_phase npc_phase( "npcs" );
     for( auto np : active_npc ) {
         if( np->is_dead() ) {
             continue;
@@ -6671,12 +6797,12 @@ void game::emp_blast( const tripoint &p )
 
 int game::npc_at( const tripoint &p ) const
 {
-    for( size_t i = 0; i < active_npc.size(); i++ ) {
-        if( active_npc[i]->pos() == p && !active_npc[i]->is_dead() ) {
-            return (int)i;
-        }
+    const npc *const who = critter_tracker->npc_at( p );
+    if( who == nullptr ) {
+        return -1;
     }
-    return -1;
+    const auto iter = std::find( active_npc.begin(), active_npc.end(), who );
+    return iter != active_npc.end() ? iter - active_npc.begin() : -1;
 }
 
 int game::npc_by_id(const int id) const
@@ -6698,11 +6824,7 @@ Creature *game::critter_at( const tripoint &p, bool allow_hallucination )
     if( p == u.pos() ) {
         return &u;
     }
-    const int nindex = npc_at( p );
-    if( nindex != -1 ) {
-        return active_npc[nindex];
-    }
-    return nullptr;
+    return critter_tracker->npc_at( p );
 }
 
 Creature const* game::critter_at( const tripoint &p, bool allow_hallucination ) const
@@ -6750,6 +6872,13 @@ monster &game::zombie(const int idx)
     return critter_tracker->find(idx);
 }
 
+void game::update_npc_pos( npc &who, const tripoint &pos )
+{
+    if( std::find( active_npc.begin(), active_npc.end(), &who ) != active_npc.end() ) {
+        critter_tracker->update_npc_pos( who, pos );
+    }
+}
+
 bool game::update_zombie_pos( const monster &critter, const tripoint &pos )
 {
     return critter_tracker->update_pos( critter, pos );
@@ -205,6 +205,12 @@ class game
         void start_calendar();
         /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
         bool do_turn();
+        /**
+         * Whether the current turn is part of a quiet period: the player sleeps or waits and
+         * there is no monster or NPC in the reality bubble. Such turns do the parts of
+         * @ref do_turn that only other creatures would notice once per minute only.
+         */
+        bool is_quiet_turn() const;
         void draw();
         void draw_ter( bool draw_sounds = true );
         void draw_ter( const tripoint &center, bool looking = false, bool draw_sounds = true );
@@ -306,6 +312,8 @@ class game
         monster &zombie(const int idx);
         /** Redirects to the creature_tracker update_pos() function. */
         bool update_zombie_pos( const monster &critter, const tripoint &pos );
+        /** Updates the location cache of npc_at for an active NPC that moves to @p pos. */
+        void update_npc_pos( npc &who, const tripoint &pos );
         void remove_zombie(const int idx);
         /** Redirects to the creature_tracker clear() function. */
         void clear_zombies();
@@ -829,6 +837,8 @@ public:
         void unload(int pos = INT_MIN);
 
         unsigned int get_seed() const;
+        /** Sets the seed without starting a game, e.g. to pre-generate a world reproducibly. */
+        void set_seed( unsigned int new_seed );
 
         /** If invoked, NPCs will be reloaded before next turn. */
         void set_npcs_dirty();
@@ -29,6 +29,8 @@ inventory::inventory()
 , invlet_cache()
 , items()
 , sorted(false)
+, binned(false)
+, qualities_binned(false)
 {
 }
 
@@ -85,8 +87,11 @@ bool inventory::is_sorted() const
 
 inventory &inventory::operator+= (const inventory &rhs)
 {
-    for (size_t i = 0; i < rhs.size(); i++) {
-        add_stack(rhs.const_stack(i));
+    // Not through add_stack, looking stacks up by index and copying them is slow for big inventories.
+    for( const auto &stack : rhs.items ) {
+        for( const auto &it : stack ) {
+            add_item( it, true );
+        }
     }
     return *this;
 }
@@ -163,11 +168,7 @@ void inventory::add_stack(const std::list<item> newits)
  */
 void inventory::clone_stack (const std::list<item> &rhs)
 {
-    std::list<item> newstack;
-    for( const auto &rh : rhs ) {
-        newstack.push_back( rh );
-    }
-    items.push_back(newstack);
+    items.push_back( rhs );
     binned = false;
 }
 
@@ -289,17 +290,17 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
 
     // See if we can't stack this item.
     for( auto &elem : items ) {
-        std::list<item>::iterator it_ref = elem.begin();
-        if( it_ref->stacks_with( newit ) ) {
-            if( it_ref->merge_charges( newit ) ) {
-                return *it_ref;
+        item &front = elem.front();
+        if( front.stacks_with( newit ) ) {
+            if( front.merge_charges( newit ) ) {
+                return front;
             }
-            newit.invlet = it_ref->invlet;
-            elem.push_back( newit );
+            newit.invlet = front.invlet;
+            elem.push_back( std::move( newit ) );
             return elem.back();
-        } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
+        } else if( keep_invlet && assign_invlet && front.invlet == newit.invlet ) {
             // If keep_invlet is true, we'll be forcing other items out of their current invlet.
-            assign_empty_invlet(*it_ref);
+            assign_empty_invlet( front );
         }
     }
 
@@ -308,9 +309,9 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
         update_cache_with_item(newit);
     }
 
-    std::list<item> newstack;
-    newstack.push_back(newit);
-    items.push_back(newstack);
+    // Moved rather than copied, copying an item copies all of its contents, tags and variables.
+    items.emplace_back();
+    items.back().push_back( std::move( newit ) );
     return items.back().back();
 }
 
@@ -407,6 +408,7 @@ static long count_charges_in_list(const itype *type, const map_stack &items)
 void inventory::form_from_map( const tripoint &origin, int range, bool assign_invlet )
 {
     items.clear();
+    binned = false;
     for( const tripoint &p : g->m.points_in_radius( origin, range ) ) {
         if (g->m.has_furn( p ) && g->m.accessible_furniture( origin, p, range )) {
             const furn_t &f = g->m.furn( p ).obj();
@@ -487,8 +489,9 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
         const int cargo = veh->part_with_feature(vpart, "CARGO");
 
         if (cargo >= 0) {
-            *this += std::list<item>( veh->get_items(cargo).begin(),
-                                      veh->get_items(cargo).end() );
+            for( const auto &it : veh->get_items( cargo ) ) {
+                add_item( it, false, false );
+            }
         }
 
         if(faupart >= 0 ) {
@@ -1087,5 +1090,40 @@ const itype_bin &inventory::get_binned_items() const
     } );
 
     binned = true;
+    qualities_binned = false;
     return binned_items;
 }
+
+const quality_bin &inventory::get_binned_qualities() const
+{
+    // Rebuilding the binned items also invalidates the qualities.
+    get_binned_items();
+    if( qualities_binned ) {
+        return binned_qualities;
+    }
+
+    binned_qualities.clear();
+    // Items in a stack are alike, so only the first one is looked at.
+    for( const auto &stack : items ) {
+        const int stack_size = stack.size();
+        stack.front().visit_items( [ this, stack_size ]( const item *e ) {
+            // Same as item::get_quality, the best level of the item and its contents.
+            std::map<quality_id, int> levels;
+            e->visit_items( [ &levels ]( const item *node ) {
+                for( const auto &q : node->type->qualities ) {
+                    auto iter = levels.emplace( q.first, q.second ).first;
+                    iter->second = std::max( iter->second, q.second );
+                }
+                return VisitResponse::NEXT;
+            } );
+            const int qty = stack_size * ( e->count_by_charges() ? int( e->charges ) : 1 );
+            for( const auto &q : levels ) {
+                binned_qualities[ q.first ][ q.second ] += qty;
+            }
+            return VisitResponse::NEXT;
+        } );
+    }
+
+    qualities_binned = true;
+    return binned_qualities;
+}
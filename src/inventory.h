@@ -7,6 +7,7 @@
 #include "enums.h"
 
 #include <list>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +22,8 @@ typedef std::vector< std::list<item>* > invslice;
 typedef std::vector< const std::list<item>* > const_invslice;
 typedef std::vector< std::pair<std::list<item>*, int> > indexed_invslice;
 typedef std::unordered_map< itype_id, std::list<const item *> > itype_bin;
+/** For each tool quality, the number of items providing it at each level. */
+typedef std::unordered_map< quality_id, std::map<int, int> > quality_bin;
 
 class salvage_actor;
 
@@ -183,6 +186,11 @@ class inventory : public visitable<inventory>
          * May not contain items that wouldn't be visited by @ref visitable methods.
          */
         const itype_bin &get_binned_items() const;
+        /**
+         * Returns the tool qualities of the visitable items, counted like
+         * @ref visitable::has_quality does. Invalidated together with the binned items.
+         */
+        const quality_bin &get_binned_qualities() const;
 
     private:
         // For each item ID, store a set of "favorite" inventory letters.
@@ -205,6 +213,13 @@ class inventory : public visitable<inventory>
          * `mutable` because this is a pure cache that doesn't affect the contained items.
          */
         mutable itype_bin binned_items;
+        /**
+         * Quality levels of the items, so checking the tools of a recipe doesn't have to
+         * visit the whole inventory for every required quality.
+         * Only valid while @ref binned is, rebuilding the binned items clears this.
+         */
+        mutable bool qualities_binned;
+        mutable quality_bin binned_qualities;
 };
 
 #endif
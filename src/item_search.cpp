@@ -5,8 +5,55 @@
 #include "output.h"
 
 #include <algorithm>
+#include <map>
+#include <memory>
 
 std::pair<std::string, std::string> get_both( const std::string &a );
+
+namespace
+{
+
+/** Same as @ref lcmatch, for a query that is already in lower case. */
+bool lower_query_match( const std::string &str, const std::string &lower_qry )
+{
+    return lower_qry.empty() ||
+           std::search( str.begin(), str.end(), lower_qry.begin(), lower_qry.end(),
+    []( const char a, const char b ) {
+        return tolower( a ) == b;
+    } ) != str.end();
+}
+
+/**
+ * Remembers the result of a predicate for each value of an attribute that is shared by many
+ * items (their category or material), so each value is matched against the query only once.
+ * Filters are copied around as std::function, so copies share the cache.
+ */
+template<typename Key>
+class match_cache
+{
+    public:
+        match_cache( const std::string &filter ) : lower_filter( filter ),
+            results( std::make_shared<std::map<Key, bool>>() ) {
+            std::transform( lower_filter.begin(), lower_filter.end(), lower_filter.begin(), tolower );
+        }
+
+        bool matches( const Key &key, const std::string &text ) const {
+            const auto iter = results->find( key );
+            if( iter != results->end() ) {
+                return iter->second;
+            }
+            const bool result = lower_query_match( text, lower_filter );
+            results->emplace( key, result );
+            return result;
+        }
+
+    private:
+        std::string lower_filter;
+        std::shared_ptr<std::map<Key, bool>> results;
+};
+
+} // namespace
+
 std::function<bool( const item & )>
 item_filter_from_string( std::string filter )
 {
@@ -69,8 +116,9 @@ item_filter_from_string( std::string filter )
     }
     bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter]( const item &i ) {
-            return !item_filter_from_string( filter.substr( 1 ) )( i );
+        const auto included = item_filter_from_string( filter.substr( 1 ) );
+        return [included]( const item &i ) {
+            return !included( i );
         };
     }
     size_t colon;
@@ -83,30 +131,40 @@ item_filter_from_string( std::string filter )
     }
     switch( flag ) {
         case 'c'://category
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category().name, filter );
+        {
+            const match_cache<const item_category *> categories( filter );
+            return [categories]( const item & i ) {
+                const item_category &cat = i.get_category();
+                return categories.matches( &cat, cat.name );
             };
-            break;
+        }
         case 'm'://material
-            return [filter]( const item & i ) {
+        {
+            const match_cache<material_id> materials( filter );
+            return [materials]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                                    [&filter]( const material_id &mat ) {
-                    return lcmatch( mat->name(), filter );
+                                    [&materials]( const material_id &mat ) {
+                    return materials.matches( mat, mat->name() );
                 } );
             };
-            break;
+        }
         case 'b'://both
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        {
+            const auto pair = get_both( filter );
+            const auto first = item_filter_from_string( pair.first );
+            const auto second = item_filter_from_string( pair.second );
+            return [first, second]( const item & i ) {
+                return first( i ) && second( i );
             };
-            break;
+        }
         default://by name
-            return [filter]( const item & a ) {
-                return lcmatch( a.tname(), filter );
+        {
+            std::string lower_filter = filter;
+            std::transform( lower_filter.begin(), lower_filter.end(), lower_filter.begin(), tolower );
+            return [lower_filter]( const item & a ) {
+                return lower_query_match( a.tname(), lower_filter );
             };
-            break;
+        }
     }
 }
 std::pair<std::string, std::string> get_both( const std::string &a )
@@ -64,7 +64,7 @@ void map::build_transparency_cache( const int zlev )
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            auto const cur_submap = get_submap_at_grid( smx, smy, zlev );
+            const submap *const cur_submap = get_submap_at_grid( smx, smy, zlev );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -82,52 +82,62 @@ void map::build_transparency_cache( const int zlev )
                     if( outside_cache[x][y] ) {
                         value *= weather_data(g->weather).sight_penalty;
                     }
+                }
+            }
 
-                    for( auto const &fld : cur_submap->fld[sx][sy] ) {
-                        const field_entry &cur = fld.second;
-                        const field_id type = cur.getFieldType();
-                        const int density = cur.getFieldDensity();
+            // Only the few tiles with fields need to look at them.
+            for( const auto &elem : cur_submap->fld ) {
+                const point sp = sparse_tile_map<field>::position( elem.first );
+                auto &value = transparency_cache[sp.x + smx * SEEX][sp.y + smy * SEEY];
+                if( value == LIGHT_TRANSPARENCY_SOLID ) {
+                    continue;
+                }
 
-                        if( fieldlist[type].transparent[density - 1] ) {
-                            continue;
-                        }
+                for( auto const &fld : elem.second ) {
+                    const field_entry &cur = fld.second;
+                    const field_id type = cur.getFieldType();
+                    const int density = cur.getFieldDensity();
 
-                        // Fields are either transparent or not, however we want some to be translucent
-                        switch (type) {
-                        case fd_cigsmoke:
-                        case fd_weedsmoke:
-                        case fd_cracksmoke:
-                        case fd_methsmoke:
-                        case fd_relax_gas:
-                            value *= 5;
-                            break;
-                        case fd_smoke:
-                        case fd_incendiary:
-                        case fd_toxic_gas:
-                        case fd_tear_gas:
-                            if (density == 3) {
-                                value = LIGHT_TRANSPARENCY_SOLID;
-                            } else if (density == 2) {
-                                value *= 10;
-                            }
-                            break;
-                        case fd_nuke_gas:
-                            value *= 10;
-                            break;
-                        case fd_fire:
-                            value *= 1.0 - ( density * 0.3 );
-                            break;
-                        default:
+                    if( fieldlist[type].transparent[density - 1] ) {
+                        continue;
+                    }
+
+                    // Fields are either transparent or not, however we want some to be translucent
+                    switch (type) {
+                    case fd_cigsmoke:
+                    case fd_weedsmoke:
+                    case fd_cracksmoke:
+                    case fd_methsmoke:
+                    case fd_relax_gas:
+                        value *= 5;
+                        break;
+                    case fd_smoke:
+                    case fd_incendiary:
+                    case fd_toxic_gas:
+                    case fd_tear_gas:
+                        if (density == 3) {
                             value = LIGHT_TRANSPARENCY_SOLID;
-                            break;
+                        } else if (density == 2) {
+                            value *= 10;
                         }
-                        // TODO: [lightmap] Have glass reduce light as well
+                        break;
+                    case fd_nuke_gas:
+                        value *= 10;
+                        break;
+                    case fd_fire:
+                        value *= 1.0 - ( density * 0.3 );
+                        break;
+                    default:
+                        value = LIGHT_TRANSPARENCY_SOLID;
+                        break;
                     }
+                    // TODO: [lightmap] Have glass reduce light as well
                 }
             }
         }
     }
     map_cache.transparency_cache_dirty = false;
+    map_cache.sees_cache.clear();
 }
 
 void map::apply_character_light( player &p )
@@ -196,7 +206,7 @@ void map::generate_lightmap( const int zlev )
     // Traverse the submaps in order
     for (int smx = 0; smx < my_MAPSIZE; ++smx) {
         for (int smy = 0; smy < my_MAPSIZE; ++smy) {
-            auto const cur_submap = get_submap_at_grid( smx, smy, zlev );
+            const submap *const cur_submap = get_submap_at_grid( smx, smy, zlev );
 
             for (int sx = 0; sx < SEEX; ++sx) {
                 for (int sy = 0; sy < SEEY; ++sy) {
@@ -232,7 +242,7 @@ void map::generate_lightmap( const int zlev )
                         add_light_source( p, 240 );
                     }
 
-                    for( auto &fld : cur_submap->fld[sx][sy] ) {
+                    for( auto &fld : cur_submap->get_field( sx, sy ) ) {
                         const field_entry *cur = &fld.second;
                         // TODO: [lightmap] Attach light brightness to fields
                         switch(cur->getFieldType()) {
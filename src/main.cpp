@@ -507,6 +507,7 @@ int main(int argc, char *argv[])
     set_escdelay(10); // Make escape actually responsive
 
     srand(seed);
+    rng_set_seed( seed );
 
     g = new game;
     // First load and initialize everything that does not
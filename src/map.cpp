@@ -160,7 +160,7 @@ const maptile map::maptile_at_internal( const tripoint &p ) const
 maptile map::maptile_at_internal( const tripoint &p )
 {
     int lx, ly;
-    submap *const sm = get_submap_at( p, lx, ly );
+    submap *const sm = unshare_submap_at( p, lx, ly );
 
     return maptile( sm, lx, ly );
 }
@@ -1280,7 +1280,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
 
     int src_offset_x, src_offset_y, dst_offset_x, dst_offset_y;
     submap *const src_submap = get_submap_at( src, src_offset_x, src_offset_y );
-    submap *const dst_submap = get_submap_at( dst, dst_offset_x, dst_offset_y );
+    submap *const dst_submap = unshare_submap_at( dst, dst_offset_x, dst_offset_y );
 
     // first, let's find our position in current vehicles vector
     int our_i = -1;
@@ -1551,7 +1551,7 @@ void map::furn_set( const tripoint &p, const furn_id new_furniture )
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
     const furn_id old_id = current_submap->get_furn( lx, ly );
     if( old_id == new_furniture ) {
         // Nothing changed
@@ -1748,7 +1748,7 @@ void map::ter_set( const tripoint &p, const ter_id new_terrain )
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
     const ter_id old_id = current_submap->get_ter( lx, ly );
     if( old_id == new_terrain ) {
         // Nothing changed
@@ -2929,13 +2929,16 @@ void map::decay_fields_and_scent( const int amount )
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
 
-                    field &fields = cur_submap->fld[sx][sy];
+                    field *const fields = cur_submap->fld.find( sx, sy );
+                    if( fields == nullptr ) {
+                        continue;
+                    }
                     if( !outside_cache[x][y] ) {
-                        to_proc -= fields.fieldCount();
+                        to_proc -= fields->fieldCount();
                         continue;
                     }
 
-                    for( auto &fp : fields ) {
+                    for( auto &fp : *fields ) {
                         to_proc--;
                         field_entry &cur = fp.second;
                         const field_id type = cur.getFieldType();
@@ -4116,25 +4119,25 @@ const std::string map::get_signage( const tripoint &p ) const
 
     return current_submap->get_signage(lx, ly);
 }
-void map::set_signage( const tripoint &p, std::string message ) const
+void map::set_signage( const tripoint &p, std::string message )
 {
     if( !inbounds( p ) ) {
         return;
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    submap * const current_submap = unshare_submap_at( p, lx, ly );
 
     current_submap->set_signage(lx, ly, message);
 }
-void map::delete_signage( const tripoint &p ) const
+void map::delete_signage( const tripoint &p )
 {
     if( !inbounds( p ) ) {
         return;
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    submap * const current_submap = unshare_submap_at( p, lx, ly );
 
     current_submap->delete_signage(lx, ly);
 }
@@ -4163,7 +4166,7 @@ void map::set_radiation( const tripoint &p, const int value)
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
 
     current_submap->set_radiation( lx, ly, value );
 }
@@ -4180,7 +4183,7 @@ void map::adjust_radiation( const tripoint &p, const int delta )
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
 
     int current_radiation = current_submap->get_radiation( lx, ly );
     current_submap->set_radiation( lx, ly, current_radiation + delta );
@@ -4193,7 +4196,7 @@ int& map::temperature( const tripoint &p )
         return null_temperature;
     }
 
-    return get_submap_at( p )->temperature;
+    return unshare_submap_at( p )->temperature;
 }
 
 void map::set_temperature( const tripoint &p, int new_temperature )
@@ -4218,9 +4221,9 @@ map_stack map::i_at( const int x, const int y )
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( x, y, lx, ly );
+    submap *const current_submap = unshare_submap_at( tripoint( x, y, abs_sub.z ), lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], tripoint( x, y, abs_sub.z ), this };
+    return map_stack{ &current_submap->get_items( lx, ly ), tripoint( x, y, abs_sub.z ), this };
 }
 
 std::list<item>::iterator map::i_rem( const point location, std::list<item>::iterator it )
@@ -4282,9 +4285,9 @@ map_stack map::i_at( const tripoint &p )
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], p, this };
+    return map_stack{ &current_submap->get_items( lx, ly ), p, this };
 }
 
 std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterator it )
@@ -4298,7 +4301,7 @@ std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterat
 
     current_submap->update_lum_rem(*it, lx, ly);
 
-    return current_submap->itm[lx][ly].erase( it );
+    return current_submap->get_items( lx, ly ).erase( it );
 }
 
 int map::i_rem(const tripoint &p, const int index)
@@ -4337,15 +4340,18 @@ void map::i_clear(const tripoint &p)
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    for( auto item_it = current_submap->itm[lx][ly].begin();
-         item_it != current_submap->itm[lx][ly].end(); ++item_it ) {
+    std::list<item> *const items = current_submap->itm.find( lx, ly );
+    if( items == nullptr ) {
+        return;
+    }
+    for( auto item_it = items->begin(); item_it != items->end(); ++item_it ) {
         if( current_submap->active_items.has( item_it, point( lx, ly ) ) ) {
             current_submap->active_items.remove( item_it, point( lx, ly ) );
         }
     }
 
     current_submap->lum[lx][ly] = 0;
-    current_submap->itm[lx][ly].clear();
+    items->clear();
 }
 
 item &map::spawn_an_item(const tripoint &p, item new_item,
@@ -4527,14 +4533,14 @@ item &map::add_item(const tripoint &p, item new_item)
         return nulitem;
     }
     int lx, ly;
-    submap * const current_submap = get_submap_at(p, lx, ly);
+    submap * const current_submap = unshare_submap_at(p, lx, ly);
 
     // Process foods when they are added to the map, here instead of add_item_at()
     // to avoid double processing food during active item processing.
     if( new_item.needs_processing() && new_item.is_food() ) {
         new_item.process( nullptr, p, false );
     }
-    return add_item_at(p, current_submap->itm[lx][ly].end(), new_item);
+    return add_item_at(p, current_submap->get_items( lx, ly ).end(), new_item);
 }
 
 item &map::add_item_at( const tripoint &p,
@@ -4553,11 +4559,11 @@ item &map::add_item_at( const tripoint &p,
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    submap * const current_submap = unshare_submap_at( p, lx, ly );
     current_submap->is_uniform = false;
 
     current_submap->update_lum_add(new_item, lx, ly);
-    const auto new_pos = current_submap->itm[lx][ly].insert( index, new_item );
+    const auto new_pos = current_submap->get_items( lx, ly ).insert( index, new_item );
     if( new_item.needs_processing() ) {
         current_submap->active_items.add( new_pos, point(lx, ly) );
     }
@@ -4578,25 +4584,19 @@ item map::water_from( const tripoint &p )
         return ret;
     }
 
-    item ret( "water", 0, item::INFINITE_CHARGES );
-    if( terrain_id == t_water_sh ) {
-        if( one_in( 3 ) ) {
-            ret.poison = rng( 1, 4 );
-        }
-        return ret;
-    }
-    if( terrain_id == t_water_dp ) {
-        if( one_in( 4 ) ) {
+    // The item is only created when there is water, this is called for every tile around the
+    // player when the crafting inventory is collected.
+    if( terrain_id == t_water_sh || terrain_id == t_water_dp ) {
+        item ret( "water", 0, item::INFINITE_CHARGES );
+        if( one_in( terrain_id == t_water_sh ? 3 : 4 ) ) {
             ret.poison = rng( 1, 4 );
         }
         return ret;
     }
     // iexamine::water_source requires a valid liquid from this function.
-    if( terrain_id.obj().examine == &iexamine::water_source ) {
-        return ret;
-    }
-    if( furn( p ).obj().examine == &iexamine::water_source ) {
-        return ret;
+    if( terrain_id.obj().examine == &iexamine::water_source ||
+        furn( p ).obj().examine == &iexamine::water_source ) {
+        return item( "water", 0, item::INFINITE_CHARGES );
     }
     return item();
 }
@@ -4611,7 +4611,7 @@ void map::make_active( item_location &loc )
     }
     int lx, ly;
     submap *const current_submap = get_submap_at( loc.position(), lx, ly );
-    auto &item_stack = current_submap->itm[lx][ly];
+    auto &item_stack = current_submap->get_items( lx, ly );
     auto iter = std::find_if( item_stack.begin(), item_stack.end(),
                               [&target]( const item &i ) { return &i == target; } );
 
@@ -4869,7 +4869,7 @@ bool map::has_items( const tripoint &p ) const
     int lx, ly;
     submap * const current_submap = get_submap_at( p, lx, ly );
 
-    return !current_submap->itm[lx][ly].empty();
+    return current_submap->has_items( lx, ly );
 }
 
 template <typename Stack>
@@ -5291,7 +5291,7 @@ void map::add_trap( const tripoint &p, const trap_id t)
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    submap * const current_submap = unshare_submap_at( p, lx, ly );
     const ter_t &ter = current_submap->get_ter( lx, ly ).obj();
     if( ter.trap != tr_null ) {
         debugmsg( "set trap %s on top of terrain %s which already has a builit-in trap",
@@ -5366,7 +5366,7 @@ void map::remove_trap( const tripoint &p )
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    submap * const current_submap = unshare_submap_at( p, lx, ly );
 
     trap_id t = current_submap->get_trap(lx, ly);
     if (t != tr_null) {
@@ -5393,9 +5393,9 @@ const field &map::field_at( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly];
+    return current_submap->get_field( lx, ly );
 }
 
 /*
@@ -5411,7 +5411,13 @@ field &map::field_at( const tripoint &p )
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly];
+    // Fields are only added through add_field, so tiles without any don't need an entry.
+    field *const fields = current_submap->fld.find( lx, ly );
+    if( fields == nullptr ) {
+        nulfield = field();
+        return nulfield;
+    }
+    return *fields;
 }
 
 int map::adjust_field_age( const tripoint &p, const field_id t, const int offset ) {
@@ -5479,7 +5485,8 @@ field_entry *map::get_field( const tripoint &p, const field_id t ) {
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly].findField( t );
+    field *const fields = current_submap->fld.find( lx, ly );
+    return fields != nullptr ? fields->findField( t ) : nullptr;
 }
 
 bool map::add_field(const tripoint &p, const field_id t, int density, const int age)
@@ -5499,10 +5506,10 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
         return false;
     }
 
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
     current_submap->is_uniform = false;
 
-    if( current_submap->fld[lx][ly].addField( t, density, age ) ) {
+    if( current_submap->get_field( lx, ly ).addField( t, density, age ) ) {
         //Only adding it to the count if it doesn't exist.
         current_submap->field_count++;
     }
@@ -5537,7 +5544,8 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
     int lx, ly;
     submap * const current_submap = get_submap_at( p, lx, ly );
 
-    if( current_submap->fld[lx][ly].removeField( field_to_remove ) ) {
+    field *const fields = current_submap->fld.find( lx, ly );
+    if( fields != nullptr && fields->removeField( field_to_remove ) ) {
         // Only adjust the count if the field actually existed.
         current_submap->field_count--;
         const auto &fdata = fieldlist[ field_to_remove ];
@@ -5654,7 +5662,7 @@ void map::add_camp( const tripoint &p, const std::string& name )
         return;
     }
 
-    get_submap_at( p )->camp = basecamp( name, p.x, p.y );
+    unshare_submap_at( p )->camp = basecamp( name, p.x, p.y );
 }
 
 void map::debug()
@@ -6183,8 +6191,26 @@ void map::draw_from_above( WINDOW* w, player &u, const tripoint &p,
 
 bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
 {
+    if( ( range >= 0 && range < rl_dist( F, T ) ) || !inbounds( T ) ) {
+        return false;
+    }
     int dummy = 0;
-    return sees( F, T, range, dummy );
+    if( F.z != T.z || !inbounds( F ) ) {
+        return sees( F, T, range, dummy );
+    }
+
+    // Monster and NPC AI ask the same questions many times per turn, the line walk
+    // only depends on the end points (the range is already checked) and the transparency.
+    const uint64_t key = ( static_cast<uint64_t>( F.x ) << 48 ) | ( static_cast<uint64_t>( F.y ) << 32 ) |
+                         ( static_cast<uint64_t>( T.x ) << 16 ) | static_cast<uint64_t>( T.y );
+    auto &memo = get_cache_ref( F.z ).sees_cache;
+    const auto iter = memo.find( key );
+    if( iter != memo.end() ) {
+        return iter->second;
+    }
+    const bool result = sees( F, T, -1, dummy );
+    memo.emplace( key, result );
+    return result;
 }
 
 /**
@@ -6661,13 +6687,10 @@ static void generate_uniform( const int x, const int y, const int z, const oter_
         return;
     }
 
-    constexpr size_t block_size = SEEX * SEEY;
+    // All of them are the same submap, it gets copied when something modifies it.
+    submap *const sm = MAPBUFFER.get_uniform_submap( fill );
     for( int xd = 0; xd <= 1; xd++ ) {
         for( int yd = 0; yd <= 1; yd++ ) {
-            submap *sm = new submap();
-            sm->is_uniform = true;
-            std::uninitialized_fill_n( &sm->ter[0][0], block_size, fill );
-            sm->turn_last_touched = int(calendar::turn);
             MAPBUFFER.add_submap( x + xd, y + yd, z, sm );
         }
     }
@@ -6709,6 +6732,10 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
         if( terrain_type == rock || terrain_type == air ) {
             generate_uniform( newmapx, newmapy, gridz, terrain_type );
         } else {
+            // Each generated map gets its own random stream derived from the world seed, so
+            // the result depends only on the location and not on what was generated before.
+            rng_engine mapgen_rng( rng_derive_seed( g->get_seed(), newmapx, newmapy, gridz ) );
+            rng_stream_scope mapgen_scope( mapgen_rng );
             tinymap tmp_map;
             tmp_map.generate( newmapx, newmapy, gridz, calendar::turn );
         }
@@ -7054,6 +7081,10 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
         debugmsg( "Actualize called on null submap (%d,%d,%d)", gridx, gridy, gridz );
         return;
     }
+    if( tmpsub->is_shared ) {
+        // Plain rock or air, nothing grows, rots or decays there.
+        return;
+    }
 
     const auto time_since_last_actualize = calendar::turn - tmpsub->turn_last_touched;
     const bool do_funnels = ( gridz >= 0 );
@@ -7066,7 +7097,9 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
             const auto &furn = this->furn( pnt ).obj();
             // plants contain a seed item which must not be removed under any circumstances
             if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
-                remove_rotten_items( tmpsub->itm[x][y], pnt );
+                if( std::list<item> *const items = tmpsub->itm.find( x, y ) ) {
+                    remove_rotten_items( *items, pnt );
+                }
             }
 
             const auto trap_here = tmpsub->get_trap( x, y );
@@ -7113,7 +7146,7 @@ void map::add_roofs( const int gridx, const int gridy, const int gridz )
         return;
     }
 
-    submap * const sub_here = get_submap_at_grid( gridx, gridy, gridz );
+    submap *sub_here = get_submap_at_grid( gridx, gridy, gridz );
     if( sub_here == nullptr ) {
         debugmsg( "Tried to add roofs/floors on null submap on %d,%d,%d",
                   gridx, gridy, gridz );
@@ -7139,6 +7172,7 @@ void map::add_roofs( const int gridx, const int gridy, const int gridz )
 
             if( !check_roof ) {
                 // Make sure we don't have open air at lowest z-level
+                sub_here = unshare_submap_at_grid( tripoint( gridx, gridy, gridz ) );
                 sub_here->ter[x][y] = t_rock_floor;
                 continue;
             }
@@ -7146,6 +7180,7 @@ void map::add_roofs( const int gridx, const int gridy, const int gridz )
             const ter_t &ter_below = sub_below->ter[x][y].obj();
             if( ter_below.roof ) {
                 // TODO: Make roof variable a ter_id to speed this up
+                sub_here = unshare_submap_at_grid( tripoint( gridx, gridy, gridz ) );
                 sub_here->ter[x][y] = ter_below.roof.id();
             }
         }
@@ -7406,7 +7441,7 @@ void map::set_graffiti( const tripoint &p, const std::string &contents )
         return;
     }
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
     current_submap->set_graffiti( lx, ly, contents );
 }
 
@@ -7416,7 +7451,7 @@ void map::delete_graffiti( const tripoint &p )
         return;
     }
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    submap *const current_submap = unshare_submap_at( p, lx, ly );
     current_submap->delete_graffiti( lx, ly );
 }
 
@@ -7621,6 +7656,11 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         }
     }
 
+    // Opaque vehicle parts may have moved.
+    for( int z = minz; z <= maxz; z++ ) {
+        get_cache( z ).sees_cache.clear();
+    }
+
     build_seen_cache( g->u.pos(), zlev );
     if( !skip_lightmap ) {
         generate_lightmap( zlev );
@@ -7797,6 +7837,35 @@ submap *map::get_submap_at_grid( const tripoint &p ) const
     return getsubmap( get_nonant( p.x, p.y, p.z ) );
 }
 
+submap *map::unshare_submap_at( const tripoint &p )
+{
+    int offset_x, offset_y;
+    return unshare_submap_at( p, offset_x, offset_y );
+}
+
+submap *map::unshare_submap_at( const tripoint &p, int &offset_x, int &offset_y )
+{
+    submap *const sm = get_submap_at( p, offset_x, offset_y );
+    if( sm == nullptr || !sm->is_shared ) {
+        return sm;
+    }
+    return unshare_submap_at_grid( tripoint( p.x / SEEX, p.y / SEEY, p.z ) );
+}
+
+submap *map::unshare_submap_at_grid( const tripoint &gridp )
+{
+    submap *const sm = get_submap_at_grid( gridp );
+    if( sm == nullptr || !sm->is_shared ) {
+        return sm;
+    }
+    // Maps that loaded the location before keep seeing the shared submap until they
+    // reload it, same as with any other submap that was replaced in the mapbuffer.
+    const tripoint abs_p( abs_sub.x + gridp.x, abs_sub.y + gridp.y, gridp.z );
+    submap *const unshared = MAPBUFFER.unshare_submap( abs_p, *sm );
+    setsubmap( get_nonant( gridp ), unshared );
+    return unshared;
+}
+
 size_t map::get_nonant( const int gridx, const int gridy ) const
 {
     return get_nonant( gridx, gridy, abs_sub.z );
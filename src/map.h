@@ -6,6 +6,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <memory>
 
 #include "game_constants.h"
@@ -152,6 +153,13 @@ struct level_cache {
     float seen_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
     lit_level visibility_cache[MAPSIZE*SEEX][MAPSIZE*SEEY];
 
+    /**
+     * Results of the line of sight checks done by @ref map::sees on this z-level, keyed by
+     * both end points. Only valid as long as transparency_cache does not change, so it is
+     * cleared whenever that is rebuilt (at least once per turn by map::build_map_cache).
+     */
+    mutable std::unordered_map<uint64_t, bool> sees_cache;
+
     bool veh_in_active_range;
     bool veh_exists_at[SEEX * MAPSIZE][SEEY * MAPSIZE];
     std::map< tripoint, std::pair<vehicle*,int> > veh_cached_parts;
@@ -182,6 +190,7 @@ struct level_cache {
 class map
 {
     friend class editmap;
+    friend class mapgen_writer;
     friend class visitable<map_cursor>;
 
  public:
@@ -776,8 +785,8 @@ void add_corpse( const tripoint &p );
 
 // Signs
     const std::string get_signage( const tripoint &p ) const;
-    void set_signage( const tripoint &p, std::string message ) const;
-    void delete_signage( const tripoint &p ) const;
+    void set_signage( const tripoint &p, std::string message );
+    void delete_signage( const tripoint &p );
 
 // Radiation
     int get_radiation( const tripoint &p ) const; // Amount of radiation at (x, y);
@@ -1368,6 +1377,14 @@ private:
         submap *get_submap_at_grid( int gridx, int gridy ) const;
         submap *get_submap_at_grid( int gridx, int gridy, int gridz ) const;
         submap *get_submap_at_grid( const tripoint &gridp ) const;
+        /**
+         * Same as @ref get_submap_at and @ref get_submap_at_grid, but a shared submap (see
+         * @ref mapbuffer::get_uniform_submap) is first replaced with a private copy, here
+         * and in the mapbuffer. Use these to get a submap that is going to be modified.
+         */
+        submap *unshare_submap_at( const tripoint &p );
+        submap *unshare_submap_at( const tripoint &p, int &offset_x, int &offset_y );
+        submap *unshare_submap_at_grid( const tripoint &gridp );
         /**
          * Get the index of a submap pointer in the grid given by grid coordinates. The grid
          * coordinates must be valid: 0 <= x < my_MAPSIZE, same for y.
@@ -7,6 +7,7 @@
 #include "filesystem.h"
 #include "overmapbuffer.h"
 #include "cata_utility.h"
+#include "save_writer.h"
 #include "mapdata.h"
 #include "worldfactory.h"
 #include "game.h"
@@ -34,9 +35,12 @@ mapbuffer::~mapbuffer()
 void mapbuffer::reset()
 {
     for( auto &elem : submaps ) {
-        delete elem.second;
+        if( !elem.second->is_shared ) {
+            delete elem.second;
+        }
     }
     submaps.clear();
+    uniform_submaps.clear();
 }
 
 bool mapbuffer::add_submap(const tripoint &p, submap *sm)
@@ -74,10 +78,38 @@ void mapbuffer::remove_submap( tripoint addr )
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
         return;
     }
-    delete m_target->second;
+    if( !m_target->second->is_shared ) {
+        delete m_target->second;
+    }
     submaps.erase( m_target );
 }
 
+submap *mapbuffer::get_uniform_submap( const ter_id &fill )
+{
+    auto &sm = uniform_submaps[fill.to_i()];
+    if( !sm ) {
+        constexpr size_t block_size = SEEX * SEEY;
+        sm.reset( new submap() );
+        sm->is_uniform = true;
+        sm->is_shared = true;
+        std::uninitialized_fill_n( &sm->ter[0][0], block_size, fill );
+    }
+    return sm.get();
+}
+
+submap *mapbuffer::unshare_submap( const tripoint &p, const submap &shared )
+{
+    submap *&sm = submaps[p];
+    if( sm != nullptr && !sm->is_shared ) {
+        // Already unshared through another map.
+        return sm;
+    }
+    sm = new submap( shared );
+    sm->is_shared = false;
+    sm->turn_last_touched = calendar::turn;
+    return sm;
+}
+
 submap *mapbuffer::lookup_submap(int x, int y, int z)
 {
     return lookup_submap( tripoint( x, y, z ) );
@@ -199,7 +231,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname.c_str() );
-    ofstream_wrapper_exclusive fout( filename );
+    // Serialized here, written to the file in the background.
+    std::ostringstream fout;
     JsonOut jsout( fout );
     jsout.start_array();
     for( auto &submap_addr : submap_addrs ) {
@@ -212,6 +245,9 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             continue;
         }
 
+        // Empty entries of the sparse per tile data are not worth saving.
+        sm->compact();
+
         jsout.start_object();
 
         jsout.member( "version", savegame_version);
@@ -279,15 +315,11 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
         jsout.member( "items" );
         jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                if( sm->itm[i][j].empty() ) {
-                    continue;
-                }
-                jsout.write( i );
-                jsout.write( j );
-                jsout.write( sm->itm[i][j] );
-            }
+        for( const auto &elem : sm->itm ) {
+            const point p = sparse_tile_map<std::list<item>>::position( elem.first );
+            jsout.write( p.x );
+            jsout.write( p.y );
+            jsout.write( elem.second );
         }
         jsout.end_array();
 
@@ -310,38 +342,32 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
         jsout.member( "fields" );
         jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save fields
-                if (sm->fld[i][j].fieldCount() > 0) {
-                    jsout.write( i );
-                    jsout.write( j );
-                    jsout.start_array();
-                    for( auto &fld : sm->fld[i][j] ) {
-                        const field_entry &cur = fld.second;
-                            // We don't seem to have a string identifier for fields anywhere.
-                            jsout.write( cur.getFieldType() );
-                            jsout.write( cur.getFieldDensity() );
-                            jsout.write( cur.getFieldAge() );
-                    }
-                    jsout.end_array();
-                }
+        for( const auto &elem : sm->fld ) {
+            // Save fields
+            const point p = sparse_tile_map<field>::position( elem.first );
+            jsout.write( p.x );
+            jsout.write( p.y );
+            jsout.start_array();
+            for( auto &fld : elem.second ) {
+                const field_entry &cur = fld.second;
+                // We don't seem to have a string identifier for fields anywhere.
+                jsout.write( cur.getFieldType() );
+                jsout.write( cur.getFieldDensity() );
+                jsout.write( cur.getFieldAge() );
             }
+            jsout.end_array();
         }
         jsout.end_array();
 
         jsout.member("cosmetics");
         jsout.start_array();
-        for (int j = 0; j < SEEY; j++) {
-            for (int i = 0; i < SEEX; i++) {
-                if (sm->cosmetics[i][j].size() > 0) {
-                    jsout.start_array();
-                    jsout.write(i);
-                    jsout.write(j);
-                    jsout.write(sm->cosmetics[i][j]);
-                    jsout.end_array();
-                }
-            }
+        for( const auto &elem : sm->cosmetics ) {
+            const point p = sparse_tile_map<std::map<std::string, std::string>>::position( elem.first );
+            jsout.start_array();
+            jsout.write( p.x );
+            jsout.write( p.y );
+            jsout.write( elem.second );
+            jsout.end_array();
         }
         jsout.end_array();
 
@@ -388,7 +414,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     }
 
     jsout.end_array();
-    fout.close();
+    save_writer::write( filename, fout.str() );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -455,13 +481,13 @@ void mapbuffer::deserialize( JsonIn &jsin )
                             if ( tid == "t_rubble" ) {
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_rubble" );
-                                sm->itm[i][j].push_back( rock );
-                                sm->itm[i][j].push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
                             } else if ( tid == "t_wreckage" ){
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_wreckage" );
-                                sm->itm[i][j].push_back( chunk );
-                                sm->itm[i][j].push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
                             } else if ( tid == "t_ash" ){
                                 sm->ter[i][j] = ter_id(  "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_ash" );
@@ -523,14 +549,14 @@ void mapbuffer::deserialize( JsonIn &jsin )
 
                         tmp.visit_items( [ &sm, i, j ]( item *it ) {
                             for( auto& e: it->magazine_convert() ) {
-                                sm->itm[i][j].push_back( e );
+                                sm->get_items( i, j ).push_back( e );
                             }
                             return VisitResponse::NEXT;
                         } );
 
-                        sm->itm[i][j].push_back( tmp );
+                        sm->get_items( i, j ).push_back( tmp );
                         if( tmp.needs_processing() ) {
-                            sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
+                            sm->active_items.add( std::prev(sm->get_items( i, j ).end()), point( i, j ) );
                         }
                     }
                 }
@@ -555,10 +581,10 @@ void mapbuffer::deserialize( JsonIn &jsin )
                         int type = jsin.get_int();
                         int density = jsin.get_int();
                         int age = jsin.get_int();
-                        if (sm->fld[i][j].findField(field_id(type)) == NULL) {
+                        if (sm->get_field( i, j ).findField(field_id(type)) == NULL) {
                             sm->field_count++;
                         }
-                        sm->fld[i][j].addField(field_id(type), density, age);
+                        sm->get_field( i, j ).addField(field_id(type), density, age);
                     }
                 }
             } else if( submap_member_name == "graffiti" ) {
@@ -576,7 +602,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                     jsin.start_array();
                     int i = jsin.get_int();
                     int j = jsin.get_int();
-                    jsin.read(sm->cosmetics[i][j]);
+                    jsin.read( sm->cosmetics( i, j ) );
                     jsin.end_array();
                 }
             } else if( submap_member_name == "spawns" ) {
@@ -7,9 +7,12 @@
 #include <memory>
 #include <string>
 #include "enums.h"
+#include "int_id.h"
 struct point;
 struct tripoint;
 struct submap;
+struct ter_t;
+using ter_id = int_id<ter_t>;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -58,6 +61,20 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Get the uniform submap filled with the given terrain. There is only one of them
+         * per terrain, it can be added at any number of locations (which makes the huge
+         * amounts of rock and open air cheap). Shared submaps are owned by the mapbuffer
+         * and must not be modified, use @ref unshare_submap first.
+         */
+        submap *get_uniform_submap( const ter_id &fill );
+        /**
+         * Replaces the shared submap @p shared at the given location with a private copy
+         * and returns the copy. If the location already has a submap of its own, that one
+         * is returned.
+         */
+        submap *unshare_submap( const tripoint &p, const submap &shared );
+
     private:
         typedef std::map<tripoint, submap *> submap_map_t;
 
@@ -79,6 +96,8 @@ class mapbuffer
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        /** Shared uniform submaps, by terrain id, see @ref get_uniform_submap. */
+        std::map<int, std::unique_ptr<submap>> uniform_submaps;
 };
 
 extern mapbuffer MAPBUFFER;
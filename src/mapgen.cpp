@@ -11,6 +11,8 @@
 #include "options.h"
 #include "item_group.h"
 #include "mapgen_functions.h"
+#include "mapgen_writer.h"
+#include "drawing_primitives.h"
 #include "mapgenformat.h"
 #include "mapbuffer.h"
 #include "overmapbuffer.h"
@@ -204,6 +206,8 @@ void map::generate(const int x, const int y, const int z, const int turn)
             dbg(D_INFO) << "map::generate: submap (" << i << "," << j << ")";
 
             if( i <= 1 && j <= 1 ) {
+                // Drop the empty per tile entries mapgen left behind by looking at tiles.
+                get_submap_at_grid( i, j, z )->compact();
                 saven( i, j, z );
             } else {
                 delete get_submap_at_grid( i, j, z );
@@ -1067,7 +1071,7 @@ public:
     jmapgen_furniture( const std::string &fid ) : jmapgen_piece(), id( furn_id( fid ) ) {}
     void apply( map &m, const jmapgen_int &x, const jmapgen_int &y, const float /*mdensity*/ ) const override
     {
-        m.furn_set( x.get(), y.get(), id );
+        mapgen_writer( m ).furn_set( x.get(), y.get(), id );
     }
 };
 /**
@@ -1081,7 +1085,7 @@ public:
     jmapgen_terrain( const std::string &tid ) : jmapgen_piece(), id( ter_id( tid ) ) {}
     void apply( map &m, const jmapgen_int &x, const jmapgen_int &y, const float /*mdensity*/ ) const override
     {
-        m.ter_set( x.get(), y.get(), id );
+        mapgen_writer( m ).ter_set( x.get(), y.get(), id );
     }
 };
 /**
@@ -1696,7 +1700,7 @@ bool jmapgen_setmap::apply( map *m ) {
     return true;
 }
 
-void mapgen_function_json::formatted_set_incredibly_simple( map * const m ) const
+void mapgen_function_json::formatted_set_incredibly_simple( mapgen_writer &w ) const
 {
     for( size_t y = 0; y < mapgensize; y++ ) {
         for( size_t x = 0; x < mapgensize; x++ ) {
@@ -1704,16 +1708,16 @@ void mapgen_function_json::formatted_set_incredibly_simple( map * const m ) cons
             const ter_furn_id &tdata = format[index];
             if( tdata.furn != f_null ) {
                 if( tdata.ter != t_null ) {
-                    m->set( x, y, tdata.ter, tdata.furn );
+                    w.set( x, y, tdata.ter, tdata.furn );
                 } else if( fill_ter != t_null ) {
-                    m->set( x, y, fill_ter, tdata.furn );
+                    w.set( x, y, fill_ter, tdata.furn );
                 } else {
-                    m->furn_set( x, y, tdata.furn );
+                    w.furn_set( x, y, tdata.furn );
                 }
             } else if( tdata.ter != t_null ) {
-                m->ter_set( x, y, tdata.ter );
+                w.ter_set( x, y, tdata.ter );
             } else if( fill_ter != t_null ) {
-                m->ter_set( x, y, fill_ter );
+                w.ter_set( x, y, fill_ter );
             }
         }
     }
@@ -1726,8 +1730,20 @@ void mapgen_function_json::generate( map *m, const oter_id &terrain_type, const
     if ( fill_ter != t_null ) {
         m->draw_fill_background( fill_ter );
     }
+    // Both rotations are applied in one go, same as rotating by one and then by the other.
+    const int terrain_turns = terrain_type->is_rotatable() ? static_cast<int>( terrain_type->get_dir() ) : 0;
+    if( setmap_points.empty() && luascript.empty() && objects.empty() ) {
+        // Only terrain and furniture, which can be written rotated right away.
+        const int turns = rotation.get() + terrain_turns;
+        if( do_format ) {
+            mapgen_writer w( *m, turns );
+            formatted_set_incredibly_simple( w );
+        }
+        return;
+    }
     if ( do_format ) {
-        formatted_set_incredibly_simple( m );
+        mapgen_writer w( *m );
+        formatted_set_incredibly_simple( w );
     }
     for( auto &elem : setmap_points ) {
         elem.apply( m );
@@ -1738,11 +1754,7 @@ void mapgen_function_json::generate( map *m, const oter_id &terrain_type, const
 
     objects.apply(m, d);
 
-    m->rotate( rotation.get() );
-
-    if( terrain_type->is_rotatable() ) {
-        mapgen_rotate(m, terrain_type, false );
-    }
+    m->rotate( rotation.get() + terrain_turns );
 }
 
 /*
@@ -8631,7 +8643,7 @@ void map::add_spawn(const mtype_id& type, int count, int x, int y, bool friendly
         return;
     }
     int offset_x, offset_y;
-    submap *place_on_submap = get_submap_at(x, y, offset_x, offset_y);
+    submap *place_on_submap = unshare_submap_at( tripoint( x, y, abs_sub.z ), offset_x, offset_y );
 
     if(!place_on_submap) {
         debugmsg("centadodecamonant doesn't exist in grid; within add_spawn(%s, %d, %d, %d)",
@@ -8704,7 +8716,7 @@ vehicle *map::add_vehicle(const vproto_id &type, const tripoint &p, const int di
     vehicle *placed_vehicle = add_vehicle_to_map( std::move( veh ), merge_wrecks );
 
     if( placed_vehicle != nullptr ) {
-        submap *place_on_submap = get_submap_at_grid( placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz );
+        submap *place_on_submap = unshare_submap_at_grid( tripoint( placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz ) );
         place_on_submap->vehicles.push_back(placed_vehicle);
         place_on_submap->is_uniform = false;
 
@@ -8841,7 +8853,7 @@ vehicle *map::add_vehicle_to_map( std::unique_ptr<vehicle> veh, const bool merge
 computer *map::add_computer( const tripoint &p, std::string name, int security )
 {
     ter_set( p, t_console ); // TODO: Turn this off?
-    submap *place_on_submap = get_submap_at( p );
+    submap *place_on_submap = unshare_submap_at( p );
     place_on_submap->comp.reset( new computer( name, security ) );
     return place_on_submap->comp.get();
 }
@@ -8948,9 +8960,13 @@ void map::rotate(int turns)
             std::swap( rotated[old_x][old_y], new_sm->ter[new_lx][new_ly] );
             std::swap( furnrot[old_x][old_y], new_sm->frn[new_lx][new_ly] );
             std::swap( traprot[old_x][old_y], new_sm->trp[new_lx][new_ly] );
-            std::swap( fldrot[old_x][old_y], new_sm->fld[new_lx][new_ly] );
-            std::swap( radrot[old_x][old_y], new_sm->rad[new_lx][new_ly] );
-            std::swap( cosmetics_rot[old_x][old_y], new_sm->cosmetics[new_lx][new_ly] );
+            fldrot[old_x][old_y] = new_sm->take_field( new_lx, new_ly );
+            radrot[old_x][old_y] = new_sm->get_radiation( new_lx, new_ly );
+            new_sm->set_radiation( new_lx, new_ly, 0 );
+            cosmetics_rot[old_x][old_y] = new_sm->take_cosmetics( new_lx, new_ly );
+            if( !new_sm->has_items( new_lx, new_ly ) ) {
+                continue;
+            }
             auto items = i_at(new_x, new_y);
             itrot[old_x][old_y].reserve( items.size() );
             // Copy items, if we move them, it'll wreck i_clear().
@@ -9077,9 +9093,9 @@ void map::rotate(int turns)
             std::swap( rotated[i][j], sm->ter[lx][ly] );
             std::swap( furnrot[i][j], sm->frn[lx][ly] );
             std::swap( traprot[i][j], sm->trp[lx][ly] );
-            std::swap( fldrot[i][j], sm->fld[lx][ly] );
-            std::swap( radrot[i][j], sm->rad[lx][ly] );
-            std::swap( cosmetics_rot[i][j], sm->cosmetics[lx][ly] );
+            sm->put_field( lx, ly, std::move( fldrot[i][j] ) );
+            sm->set_radiation( lx, ly, radrot[i][j] );
+            sm->put_cosmetics( lx, ly, std::move( cosmetics_rot[i][j] ) );
             for( auto &itm : itrot[i][j] ) {
                 add_item( i, j, itm );
             }
@@ -11076,13 +11092,20 @@ void map::create_anomaly( const tripoint &cp, artifact_natural_property prop )
 }
 ///////////////////// part of map
 
+// The builtin mapgen helpers write through a mapgen_writer, see there.
 void line( map *m, const ter_id type, int x1, int y1, int x2, int y2 )
 {
-    m->draw_line_ter( type, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_line( [&w, type]( int x, int y ) {
+        w.ter_set( x, y, type );
+    }, x1, y1, x2, y2 );
 }
 void line_furn( map *m, furn_id type, int x1, int y1, int x2, int y2 )
 {
-    m->draw_line_furn( type, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_line( [&w, type]( int x, int y ) {
+        w.furn_set( x, y, type );
+    }, x1, y1, x2, y2 );
 }
 void fill_background( map *m, ter_id type )
 {
@@ -11090,47 +11113,77 @@ void fill_background( map *m, ter_id type )
 }
 void fill_background( map *m, ter_id( *f )() )
 {
-    m->draw_fill_background( f );
+    square( m, f, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1 );
 }
 void fill_background( map *m, const id_or_id<ter_t> &f )
 {
-    m->draw_fill_background( f );
+    mapgen_writer w( *m );
+    draw_square( [&w, &f]( int x, int y ) {
+        w.ter_set( x, y, f.get() );
+    }, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1 );
 }
 void square( map *m, ter_id type, int x1, int y1, int x2, int y2 )
 {
-    m->draw_square_ter( type, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_square( [&w, type]( int x, int y ) {
+        w.ter_set( x, y, type );
+    }, x1, y1, x2, y2 );
 }
 void square_furn( map *m, furn_id type, int x1, int y1, int x2, int y2 )
 {
-    m->draw_square_furn( type, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_square( [&w, type]( int x, int y ) {
+        w.furn_set( x, y, type );
+    }, x1, y1, x2, y2 );
 }
 void square( map *m, ter_id( *f )(), int x1, int y1, int x2, int y2 )
 {
-    m->draw_square_ter( f, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_square( [&w, f]( int x, int y ) {
+        w.ter_set( x, y, f() );
+    }, x1, y1, x2, y2 );
 }
 void square( map *m, const id_or_id<ter_t> &f, int x1, int y1, int x2, int y2 )
 {
-    m->draw_square_ter( f, x1, y1, x2, y2 );
+    mapgen_writer w( *m );
+    draw_square( [&w, &f]( int x, int y ) {
+        w.ter_set( x, y, f.get() );
+    }, x1, y1, x2, y2 );
 }
 void rough_circle( map *m, ter_id type, int x, int y, int rad )
 {
-    m->draw_rough_circle_ter( type, x, y, rad );
+    mapgen_writer w( *m );
+    draw_rough_circle( [&w, type]( int x, int y ) {
+        w.ter_set( x, y, type );
+    }, x, y, rad );
 }
 void rough_circle_furn( map *m, furn_id type, int x, int y, int rad )
 {
-    m->draw_rough_circle_furn( type, x, y, rad );
+    mapgen_writer w( *m );
+    draw_rough_circle( [&w, type]( int x, int y ) {
+        w.furn_set( x, y, type );
+    }, x, y, rad );
 }
 void circle( map *m, ter_id type, double x, double y, double rad )
 {
-    m->draw_circle_ter( type, x, y, rad );
+    mapgen_writer w( *m );
+    draw_circle( [&w, type]( int x, int y ) {
+        w.ter_set( x, y, type );
+    }, x, y, rad );
 }
 void circle( map *m, ter_id type, int x, int y, int rad )
 {
-    m->draw_circle_ter( type, x, y, rad );
+    mapgen_writer w( *m );
+    draw_circle( [&w, type]( int x, int y ) {
+        w.ter_set( x, y, type );
+    }, x, y, rad );
 }
 void circle_furn( map *m, furn_id type, int x, int y, int rad )
 {
-    m->draw_circle_furn( type, x, y, rad );
+    mapgen_writer w( *m );
+    draw_circle( [&w, type]( int x, int y ) {
+        w.furn_set( x, y, type );
+    }, x, y, rad );
 }
 void add_corpse( map *m, int x, int y )
 {
@@ -12,6 +12,7 @@ struct oter_t;
 using oter_id = int_id<oter_t>;
 
 struct mapgendata;
+class mapgen_writer;
 typedef void (*building_gen_pointer)(map *,oter_id,mapgendata,int,float);
 
 //////////////////////////////////////////////////////////////////////////
@@ -225,6 +226,10 @@ struct jmapgen_objects {
 
     void apply(map* m, float density) const;
 
+    bool empty() const {
+        return objects.empty();
+    }
+
 private:
     /**
      * Combination of where to place something and what to place.
@@ -266,7 +271,7 @@ private:
     jmapgen_objects objects;
     jmapgen_int rotation;
 
-    void formatted_set_incredibly_simple( map *m ) const;
+    void formatted_set_incredibly_simple( mapgen_writer &w ) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////
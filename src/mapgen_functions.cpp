@@ -1,5 +1,6 @@
 #include "mapgen.h"
 #include "mapgen_functions.h"
+#include "mapgen_writer.h"
 #include "map_iterator.h"
 #include "output.h"
 #include "item_factory.h"
@@ -438,9 +439,9 @@ void mapgen_crater(map *m, oter_id, mapgendata dat, int, float)
 // todo: make void map::ter_or_furn_set(const int x, const int y, const ter_furn_id & tfid);
 void ter_or_furn_set( map * m, const int x, const int y, const ter_furn_id & tfid ) {
     if ( tfid.ter != t_null ) {
-        m->ter_set(x, y, tfid.ter );
+        mapgen_writer( *m ).ter_set( x, y, tfid.ter );
     } else if ( tfid.furn != f_null ) {
-        m->furn_set(x, y, tfid.furn );
+        mapgen_writer( *m ).furn_set( x, y, tfid.furn );
     }
 }
 
@@ -0,0 +1,105 @@
+#include "mapgen_writer.h"
+
+#include "game_constants.h"
+#include "map.h"
+#include "mapdata.h"
+#include "submap.h"
+
+mapgen_writer::mapgen_writer( map &m, const int turns ) : turns( turns % 4 )
+{
+    const int z = m.get_abs_sub().z;
+    for( int gridx = 0; gridx < 2; gridx++ ) {
+        for( int gridy = 0; gridy < 2; gridy++ ) {
+            quad[gridx][gridy] = m.unshare_submap_at_grid( tripoint( gridx, gridy, z ) );
+        }
+    }
+}
+
+submap *mapgen_writer::locate( const int x, const int y, int &lx, int &ly ) const
+{
+    if( x < 0 || y < 0 || x >= SEEX * 2 || y >= SEEY * 2 ) {
+        return nullptr;
+    }
+    // Same mapping as map::rotate.
+    int rx = x;
+    int ry = y;
+    switch( turns ) {
+        case 1:
+            rx = SEEY * 2 - 1 - y;
+            ry = x;
+            break;
+        case 2:
+            rx = SEEX * 2 - 1 - x;
+            ry = SEEY * 2 - 1 - y;
+            break;
+        case 3:
+            rx = y;
+            ry = SEEX * 2 - 1 - x;
+            break;
+    }
+    lx = rx % SEEX;
+    ly = ry % SEEY;
+    return quad[rx / SEEX][ry / SEEY];
+}
+
+ter_id mapgen_writer::rotate_ter( const ter_id &t ) const
+{
+    if( turns % 2 == 0 ) {
+        return t;
+    }
+    // Rotate things like walls 90 degrees, as map::rotate does
+    if( t == t_railing_v ) {
+        return t_railing_h;
+    } else if( t == t_railing_h ) {
+        return t_railing_v;
+    } else if( t == t_fence_v ) {
+        return t_fence_h;
+    } else if( t == t_fence_h ) {
+        return t_fence_v;
+    } else if( t == t_chainfence_h ) {
+        return t_chainfence_v;
+    } else if( t == t_chainfence_v ) {
+        return t_chainfence_h;
+    }
+    return t;
+}
+
+ter_id mapgen_writer::ter( const int x, const int y ) const
+{
+    int lx, ly;
+    const submap *const sm = locate( x, y, lx, ly );
+    return sm != nullptr ? rotate_ter( sm->get_ter( lx, ly ) ) : t_null;
+}
+
+furn_id mapgen_writer::furn( const int x, const int y ) const
+{
+    int lx, ly;
+    const submap *const sm = locate( x, y, lx, ly );
+    return sm != nullptr ? sm->get_furn( lx, ly ) : f_null;
+}
+
+void mapgen_writer::ter_set( const int x, const int y, const ter_id &new_terrain )
+{
+    int lx, ly;
+    submap *const sm = locate( x, y, lx, ly );
+    if( sm == nullptr ) {
+        return;
+    }
+    sm->set_ter( lx, ly, rotate_ter( new_terrain ) );
+}
+
+void mapgen_writer::furn_set( const int x, const int y, const furn_id &new_furniture )
+{
+    int lx, ly;
+    submap *const sm = locate( x, y, lx, ly );
+    if( sm != nullptr ) {
+        sm->set_furn( lx, ly, new_furniture );
+    }
+}
+
+void mapgen_writer::set( const int x, const int y, const ter_id &new_terrain,
+                         const furn_id &new_furniture )
+{
+    furn_set( x, y, new_furniture );
+    ter_set( x, y, new_terrain );
+}
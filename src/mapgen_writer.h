@@ -0,0 +1,50 @@
+#pragma once
+#ifndef MAPGEN_WRITER_H
+#define MAPGEN_WRITER_H
+
+#include "int_id.h"
+
+class map;
+struct submap;
+struct ter_t;
+struct furn_t;
+using ter_id = int_id<ter_t>;
+using furn_id = int_id<furn_t>;
+
+/**
+ * Minimal write target for mapgen: terrain and furniture of the 2x2 submaps that make up
+ * the overmap terrain tile at the top left of a map.
+ *
+ * Unlike @ref map::ter_set and @ref map::furn_set, writes go straight into the submaps.
+ * No caches are dirtied, no trap locations updated and no support checks queued. That
+ * bookkeeping is pointless for a tinymap that is generated (or changed by a map special)
+ * and saved right away; don't use this on the map the player is on.
+ *
+ * Coordinates are relative to the top left of the tile, writes outside of it are ignored.
+ * With a rotation, each write lands where @ref map::rotate would move it to, so writing
+ * rotated gives the same terrain as writing unrotated and rotating afterwards.
+ */
+class mapgen_writer
+{
+    public:
+        /** @param turns Clockwise quarter turns applied to the written coordinates. */
+        mapgen_writer( map &m, int turns = 0 );
+
+        ter_id ter( int x, int y ) const;
+        furn_id furn( int x, int y ) const;
+
+        void ter_set( int x, int y, const ter_id &new_terrain );
+        void furn_set( int x, int y, const furn_id &new_furniture );
+        void set( int x, int y, const ter_id &new_terrain, const furn_id &new_furniture );
+
+    private:
+        /** Submap containing (rotated) @p x, @p y and the position on it, nullptr if outside. */
+        submap *locate( int x, int y, int &lx, int &ly ) const;
+        /** Horizontal and vertical variants of fences swap places on odd rotations. */
+        ter_id rotate_ter( const ter_id &t ) const;
+
+        submap *quad[2][2];
+        int turns;
+};
+
+#endif
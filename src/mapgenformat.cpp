@@ -10,6 +10,7 @@
 #include "mapdata.h"
 #include "map.h"
 #include "mapgenformat.h"
+#include "mapgen_writer.h"
 
 namespace mapf
 {
@@ -17,6 +18,7 @@ namespace mapf
 void formatted_set_simple( map *m, const int startx, const int starty, const char *cstr,
                            format_effect<ter_id> ter_b, format_effect<furn_id> furn_b )
 {
+    mapgen_writer w( *m );
     const char *p = cstr;
     int x = startx;
     int y = starty;
@@ -28,13 +30,13 @@ void formatted_set_simple( map *m, const int startx, const int starty, const cha
             const ter_id ter = ter_b.translate( *p );
             const furn_id furn = furn_b.translate( *p );
             if( ter != t_null ) {
-                m->ter_set( x, y, ter );
+                w.ter_set( x, y, ter );
             }
             if( furn != f_null ) {
                 if( furn == f_toilet ) {
                     m->place_toilet( x, y );
                 } else {
-                    m->furn_set( x, y, furn );
+                    w.furn_set( x, y, furn );
                 }
             }
             x++;
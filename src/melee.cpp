@@ -299,6 +299,7 @@ static void melee_train( player &p, int lo, int hi ) {
 
 void player::melee_attack( Creature &t, bool allow_special, const matec_id &force_technique )
 {
+    rng_stream_scope combat_rng( rng_stream::combat );
     int hitspread = t.deal_melee_attack( this, hit_roll() );
     melee_attack( t, allow_special, force_technique, hitspread );
 }
@@ -307,6 +308,7 @@ void player::melee_attack( Creature &t, bool allow_special, const matec_id &forc
 // we calculate if we would hit. In Creature::deal_melee_hit, we calculate if the target dodges.
 void player::melee_attack(Creature &t, bool allow_special, const matec_id &force_technique, int hit_spread)
 {
+    rng_stream_scope combat_rng( rng_stream::combat );
     if( !t.is_player() ) {
         // @todo Per-NPC tracking? Right now monster hit by either npc or player will draw aggro...
         t.add_effect( effect_hit_by_player, 100 ); // Flag as attacked by us for AI
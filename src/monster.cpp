@@ -956,12 +956,14 @@ void monster::absorb_hit(body_part, damage_instance &dam) {
 
 void monster::melee_attack( Creature &target, bool allow_special, const matec_id& force_technique )
 {
+    rng_stream_scope combat_rng( rng_stream::combat );
     int hitspread = target.deal_melee_attack(this, hit_roll());
     melee_attack( target, allow_special, force_technique, hitspread );
 }
 
 void monster::melee_attack( Creature &target, bool, const matec_id&, int hitspread )
 {
+    rng_stream_scope combat_rng( rng_stream::combat );
     mod_moves( -type->attack_cost );
     if( type->melee_dice == 0 ) {
         // We don't attack, so just return
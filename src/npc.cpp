@@ -1863,6 +1863,7 @@ std::string npc::opinion_text() const
 
 void npc::setpos( const tripoint &pos )
 {
+    g->update_npc_pos( *this, pos );
     position = pos;
     const point pos_om_old = sm_to_om_copy( submap_coords );
     submap_coords.x = g->get_levx() + pos.x / SEEX;
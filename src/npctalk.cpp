@@ -4427,18 +4427,7 @@ bool npc::item_name_whitelisted( const std::string &to_match )
         return true;
     }
 
-    auto &wlist = *rules.pickup_whitelist;
-    const auto rule = wlist.check_item( to_match );
-    if( rule == RULE_WHITELISTED ) {
-        return true;
-    }
-
-    if( rule == RULE_BLACKLISTED ) {
-        return false;
-    }
-
-    wlist.create_rule( to_match );
-    return wlist.check_item( to_match ) == RULE_WHITELISTED;
+    return rules.pickup_whitelist->check_item( to_match ) == RULE_WHITELISTED;
 }
 
 bool npc::item_whitelisted( const item &it )
@@ -1170,6 +1170,21 @@ void options_manager::init()
         0, 100, 10
         );
 
+    add("ANIMATION_BUDGET_PROJECTILE", "graphics", _("Projectile animation time"),
+        _("The most time in ms per turn that projectile animations may pause the game.  Further projectiles of that turn are shown without pausing.  0 for no limit."),
+        0, 10000, 1000
+        );
+
+    add("ANIMATION_BUDGET_EXPLOSION", "graphics", _("Explosion animation time"),
+        _("The most time in ms per turn that explosion animations may pause the game.  Further explosions of that turn are shown without pausing.  0 for no limit."),
+        0, 10000, 1500
+        );
+
+    add("ANIMATION_BUDGET_HIT", "graphics", _("Hit animation time"),
+        _("The most time in ms per turn that animations of creatures getting hit may pause the game.  0 for no limit."),
+        0, 10000, 300
+        );
+
     add("FORCE_REDRAW", "graphics", _("Force redraw"),
         _("If true, forces the game to redraw at least once per turn."),
         true
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <algorithm>
 #include <map>
+#include <locale>
 #include <errno.h>
 
 #include "output.h"
@@ -2200,46 +2201,64 @@ int msgtype_to_tilecolor( const game_message_type type, const bool bOldMsg )
  **/
 bool wildcard_match(const std::string &text_in, const std::string &pattern_in)
 {
-    std::string text = text_in;
+    return wildcard_pattern( pattern_in ).matches( text_in );
+}
 
-    if (text == "") {
-        return false;
-    } else if (text == "*") {
-        return true;
+/** Upper-cases each character like @ref ci_find_substr compares them. */
+static std::string ci_fold( const std::string &text )
+{
+    const std::locale loc;
+    std::string result = text;
+    for( char &ch : result ) {
+        ch = std::toupper( ch, loc );
     }
+    return result;
+}
 
-    int pos;
-    std::vector<std::string> pattern;
+wildcard_pattern::wildcard_pattern( const std::string &pattern )
+{
+    wildcard_split( wildcard_trim_rule( pattern ), '*', pieces );
+    for( std::string &piece : pieces ) {
+        piece = ci_fold( piece );
+    }
+}
 
-    wildcard_split(wildcard_trim_rule(pattern_in), '*', pattern);
+bool wildcard_pattern::matches( const std::string &text_in ) const
+{
+    if( text_in.empty() ) {
+        return false;
+    } else if( text_in == "*" ) {
+        return true;
+    }
 
-    if (pattern.size() == 1) { // no * found
-        return (text.length() == pattern[0].length() && ci_find_substr(text, pattern[0]) != -1);
+    const std::string text = ci_fold( text_in );
+    if( pieces.size() == 1 ) { // no * found
+        return text == pieces[0];
     }
 
-    for (auto it = pattern.begin(); it != pattern.end(); ++it) {
-        if (it == pattern.begin() && *it != "") {
-            if (text.length() < it->length() ||
-                ci_find_substr(text.substr(0, it->length()), *it) == -1) {
+    // Start of the part of the text that is not matched yet.
+    size_t start = 0;
+    for( size_t i = 0; i < pieces.size(); i++ ) {
+        const std::string &piece = pieces[i];
+        if( piece.empty() ) {
+            continue;
+        }
+        if( i == 0 ) {
+            if( text.compare( 0, piece.length(), piece ) != 0 ) {
                 return false;
             }
-
-            text = text.substr(it->length(), text.length() - it->length());
-        } else if (it == pattern.end() - 1 && *it != "") {
-            if (text.length() < it->length() ||
-                ci_find_substr(text.substr(text.length() - it->length(),
-                                            it->length()), *it) == -1) {
+            start = piece.length();
+        } else if( i == pieces.size() - 1 ) {
+            if( text.length() - start < piece.length() ||
+                text.compare( text.length() - piece.length(), piece.length(), piece ) != 0 ) {
                 return false;
             }
         } else {
-            if (!(*it).empty()) {
-                pos = ci_find_substr(text, *it);
-                if (pos == -1) {
-                    return false;
-                }
-
-                text = text.substr(pos + (int)it->length(), (int)text.length() - pos);
+            const size_t pos = text.find( piece, start );
+            if( pos == std::string::npos ) {
+                return false;
             }
+            start = pos + piece.length();
         }
     }
 
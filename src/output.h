@@ -601,6 +601,20 @@ extern scrollingcombattext SCT;
 
 std::string wildcard_trim_rule( const std::string &sPatternIn );
 bool wildcard_match( const std::string &sTextIn, const std::string &sPatternIn );
+/**
+ * A pattern for @ref wildcard_match, split and upper-cased once, so matching it against many
+ * texts does not repeat that work.
+ */
+class wildcard_pattern
+{
+    public:
+        wildcard_pattern( const std::string &pattern );
+        /** Same as wildcard_match( text, pattern ). */
+        bool matches( const std::string &text ) const;
+
+    private:
+        std::vector<std::string> pieces;
+};
 std::vector<std::string> &wildcard_split( const std::string &s, char delim, std::vector<std::string> &elems );
 int ci_find_substr( const std::string &str1, const std::string &str2, const std::locale &loc = std::locale() );
 
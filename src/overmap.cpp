@@ -34,6 +34,7 @@
 #include "messages.h"
 #include "rotatable_symbols.h"
 #include "string_input_popup.h"
+#include "save_writer.h"
 
 #include <cassert>
 #include <stdlib.h>
@@ -1280,6 +1281,9 @@ oter_id &overmap::ter(const int x, const int y, const int z)
     if( !inbounds( x, y, z ) ) {
         return ot_null;
     }
+    if( !packed_terrain[z + OVERMAP_DEPTH].empty() ) {
+        unpack_terrain( z + OVERMAP_DEPTH );
+    }
 
     return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
@@ -1289,6 +1293,9 @@ const oter_id overmap::get_ter(const int x, const int y, const int z) const
     if( !inbounds( x, y, z ) ) {
         return ot_null;
     }
+    if( !packed_terrain[z + OVERMAP_DEPTH].empty() ) {
+        unpack_terrain( z + OVERMAP_DEPTH );
+    }
 
     return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
@@ -1531,6 +1538,7 @@ void overmap::set_scent( const tripoint &loc, scent_trace &new_scent )
 void overmap::generate(const overmap *north, const overmap *east,
                        const overmap *south, const overmap *west)
 {
+    rng_stream_scope mapgen_rng( rng_stream::mapgen );
     dbg(D_INFO) << "overmap::generate start...";
     std::vector<point> river_start;// West/North endpoints of rivers
     std::vector<point> river_end; // East/South endpoints of rivers
@@ -4275,7 +4283,7 @@ void overmap::place_specials()
         }
 
         if( elem->flags.count( "UNIQUE" ) > 0 ) {
-            if( rand() % max <= min ) {
+            if( rng( 0, max - 1 ) <= min ) {
                 mandatory.emplace_back( elem, 1 );
             }
         } else {
@@ -4561,19 +4569,19 @@ void overmap::generate_outer( const overmap* north, const overmap* east, const o
     } while( current_validity < minimum_validity );
 }
 
-// Note: this may throw io errors from std::ofstream
+// Note: the files are written in the background, see save_writer
 void overmap::save() const
 {
     std::string const plrfilename = overmapbuffer::player_filename(loc.x, loc.y);
     std::string const terfilename = overmapbuffer::terrain_filename(loc.x, loc.y);
 
-    ofstream_wrapper fout_player( plrfilename );
+    std::ostringstream fout_player;
     serialize_view( fout_player );
-    fout_player.close();
+    save_writer::write( plrfilename, fout_player.str() );
 
-    ofstream_wrapper_exclusive fout_terrain( terfilename );
+    std::ostringstream fout_terrain;
     serialize( fout_terrain );
-    fout_terrain.close();
+    save_writer::write( terfilename, fout_terrain.str() );
 }
 
 
@@ -307,6 +307,13 @@ public:
     point loc{ 0, 0 };
 
     std::array<map_layer, OVERMAP_LAYERS> layer;
+    /**
+     * Terrain of the z-levels that were loaded but not looked at yet, in the run length
+     * encoding of the save (indices into @ref packed_terrain_table). A layer is decoded
+     * into @ref map_layer::terrain on its first access, which empties its entry here.
+     */
+    mutable std::array<std::string, OVERMAP_LAYERS> packed_terrain;
+    std::vector<oter_id> packed_terrain_table;
     std::unordered_map<tripoint, scent_trace> scents;
 
     /**
@@ -353,6 +360,11 @@ public:
   void unserialize_legacy(std::istream &fin);
   void unserialize_view_legacy(std::istream &fin);
  private:
+  // Binary terrain layers at the start of the overmap file
+  void serialize_terrain( std::ostream &fout ) const;
+  void unserialize_terrain( std::istream &fin );
+  // Decodes the packed terrain of the z-level index @p z (0 is the lowest)
+  void unpack_terrain( int z ) const;
   void generate(const overmap* north, const overmap* east, const overmap* south, const overmap* west);
   // Controls error handling in generation
   void generate_outer(const overmap* north, const overmap* east, const overmap* south, const overmap* west);
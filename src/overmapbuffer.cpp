@@ -14,6 +14,7 @@
 #include "vehicle.h"
 #include "filesystem.h"
 #include "cata_utility.h"
+#include "save_writer.h"
 
 #include <algorithm>
 #include <cassert>
@@ -192,7 +193,10 @@ overmap *overmapbuffer::get_existing(int x, int y)
         // checked in a previous call of this function).
         return NULL;
     }
-    if( file_exist( terrain_filename( x, y ) ) ) {
+    const std::string terfilename = terrain_filename( x, y );
+    // It may not have been written yet if it got saved and unloaded recently.
+    save_writer::wait_for( terfilename );
+    if( file_exist( terfilename ) ) {
         // File exists, load it normally (the get function
         // indirectly call overmap::open to do so).
         return &get( x, y );
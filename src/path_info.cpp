@@ -101,6 +101,8 @@ void PATH_INFO::update_config_dir()
     update_pathname("options", FILENAMES["config_dir"] + "options.json");
     update_pathname("keymap", FILENAMES["config_dir"] + "keymap.txt");
     update_pathname("debug", FILENAMES["config_dir"] + "debug.log");
+    update_pathname("turn_profile", FILENAMES["config_dir"] + "turn_profile.csv");
+    update_pathname("turn_trace", FILENAMES["config_dir"] + "turn_trace.json");
     update_pathname("fontlist", FILENAMES["config_dir"] + "fontlist.txt");
     update_pathname("fontdata", FILENAMES["config_dir"] + "fonts.json");
     update_pathname("autopickup", FILENAMES["config_dir"] + "auto_pickup.json");
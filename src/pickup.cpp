@@ -287,16 +287,9 @@ static bool select_autopickup_items( std::vector<std::list<item_idx>> &here,
                 const std::string sItemName = here[i].begin()->_item.tname( 1, false );
 
                 //Check the Pickup Rules
-                if( get_auto_pickup().check_item( sItemName ) == RULE_WHITELISTED ) {
+                const rule_state rule = get_auto_pickup().check_item( sItemName );
+                if( rule == RULE_WHITELISTED ) {
                     bPickup = true;
-                } else if( get_auto_pickup().check_item( sItemName ) != RULE_BLACKLISTED ) {
-                    //No prematched pickup rule found
-                    //items with damage, (fits) or a container
-                    get_auto_pickup().create_rule( sItemName );
-
-                    if( get_auto_pickup().check_item( sItemName ) == RULE_WHITELISTED ) {
-                        bPickup = true;
-                    }
                 }
 
                 //Auto Pickup all items with Volume <= AUTO_PICKUP_VOL_LIMIT * 50 and Weight <= AUTO_PICKUP_ZERO * 50
@@ -307,7 +300,7 @@ static bool select_autopickup_items( std::vector<std::list<item_idx>> &here,
                     if( weight_limit && volume_limit ) {
                         if( here[i].begin()->_item.volume() <= units::from_milliliter( volume_limit * 50 ) &&
                             here[i].begin()->_item.weight() <= weight_limit * 50 &&
-                            get_auto_pickup().check_item( sItemName ) != RULE_BLACKLISTED ) {
+                            rule != RULE_BLACKLISTED ) {
                             bPickup = true;
                         }
                     }
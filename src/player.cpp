@@ -10697,8 +10697,37 @@ int player::has_recipe( const recipe *r, const inventory &crafting_inv,
         return r->difficulty;
     }
 
-    const auto available = get_available_recipes( crafting_inv, &helpers );
-    return available.contains( r ) ? available.get_custom_difficulty( r ) : -1;
+    // Same result as looking the recipe up in get_available_recipes, but without copying all
+    // the known recipes for each recipe that's checked.
+    int difficulty = -1;
+    const auto include = [&difficulty]( const int d ) {
+        if( difficulty < 0 || d < difficulty ) {
+            difficulty = d;
+        }
+    };
+    const auto include_books = [ this, r, &include ]( const inventory & inv ) {
+        const islot_book::recipe_with_description_t key{ r, 0, std::string(), false };
+        for( const auto &stack : inv.const_slice() ) {
+            const item &candidate = stack->front();
+            if( !candidate.is_book() || ( is_player() && !items_identified.count( candidate.typeId() ) ) ) {
+                continue;
+            }
+            const auto iter = candidate.type->book->recipes.find( key );
+            if( iter != candidate.type->book->recipes.end() &&
+                get_skill_level( r->skill_used ) >= iter->skill_level ) {
+                include( iter->skill_level );
+            }
+        }
+    };
+
+    include_books( crafting_inv );
+    for( npc *np : helpers ) {
+        include_books( np->inv );
+        if( np->knows_recipe( r ) && get_skill_level( r->skill_used ) >= int( r->difficulty * 0.8f ) ) {
+            include( r->difficulty );
+        }
+    }
+    return difficulty;
 }
 
 void player::learn_recipe( const recipe * const rec )
@@ -10931,8 +10960,7 @@ bool player::uncanny_dodge()
     tripoint adjacent = adjacent_tile();
     charge_power(-75);
     if( adjacent.x != posx() || adjacent.y != posy()) {
-        position.x = adjacent.x;
-        position.y = adjacent.y;
+        setpos( tripoint( adjacent.x, adjacent.y, posz() ) );
         if( is_u ) {
             add_msg( _("Time seems to slow down and you instinctively dodge!") );
         } else if( seen ) {
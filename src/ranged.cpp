@@ -168,6 +168,7 @@ int player::fire_gun( const tripoint &target, int shots )
 
 int player::fire_gun( const tripoint &target, int shots, item& gun )
 {
+    rng_stream_scope combat_rng( rng_stream::combat );
     if( !gun.is_gun() ) {
         debugmsg( "%s tried to fire non-gun (%s).", name.c_str(), gun.tname().c_str() );
         return 0;
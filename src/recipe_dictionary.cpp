@@ -7,6 +7,7 @@
 #include "cata_utility.h"
 #include "crafting.h"
 #include "skill.h"
+#include "options.h"
 
 #include <algorithm>
 #include <numeric>
@@ -47,63 +48,115 @@ const recipe &recipe_dictionary::get_uncraft( const itype_id &id )
     return iter != recipe_dict.uncraft.end() ? iter->second : null_recipe;
 }
 
-// searches for left-anchored partial match in the relevant recipe requirements set
+namespace
+{
+
+std::string lowercase( const std::string &str )
+{
+    std::string res;
+    res.reserve( str.size() );
+    std::transform( str.begin(), str.end(), std::back_inserter( res ), tolower );
+    return res;
+}
+
+// texts of the relevant recipe requirements set, one per line so a match can't span two
 template <class group>
-bool search_reqs( group gp, const std::string &txt )
+std::string reqs_text( const group &gp )
 {
-    return std::any_of( gp.begin(), gp.end(), [&]( const typename group::value_type & opts ) {
-        return std::any_of( opts.begin(),
-        opts.end(), [&]( const typename group::value_type::value_type & e ) {
-            return lcmatch( e.to_string(), txt );
-        } );
-    } );
+    std::string res;
+    for( const auto &opts : gp ) {
+        for( const auto &e : opts ) {
+            res += e.to_string();
+            res += '\n';
+        }
+    }
+    return res;
 }
 // template specialization to make component searches easier
 template<>
-bool search_reqs( std::vector<std::vector<item_comp> >  gp,
-                  const std::string &txt )
+std::string reqs_text( const std::vector<std::vector<item_comp> > &gp )
 {
-    return std::any_of( gp.begin(), gp.end(), [&]( const std::vector<item_comp> &opts ) {
-        return std::any_of( opts.begin(), opts.end(), [&]( const item_comp & ic ) {
-            return lcmatch( item::nname( ic.type ), txt );
-        } );
-    } );
+    std::string res;
+    for( const auto &opts : gp ) {
+        for( const item_comp &ic : opts ) {
+            res += item::nname( ic.type );
+            res += '\n';
+        }
+    }
+    return res;
 }
 
-std::vector<const recipe *> recipe_subset::search( const std::string &txt,
-        const search_type key ) const
+/**
+ * Lowercased texts matched by @ref recipe_subset::search, by search type. Built when a
+ * recipe is first searched, so a search doesn't translate and lowercase every recipe.
+ */
+std::map<const recipe *, std::vector<std::string>> search_texts;
+/** Language the texts are translated to. */
+std::string search_texts_language;
+/** Changes whenever the texts are dropped, so cached search results can tell they're stale. */
+int search_texts_generation = 0;
+
+void clear_search_texts()
 {
-    std::vector<const recipe *> res;
-
-    std::copy_if( recipes.begin(), recipes.end(), std::back_inserter( res ), [&]( const recipe * r ) {
-        switch( key ) {
-            case search_type::name:
-                return lcmatch( item::nname( r->result ), txt );
-
-            case search_type::skill:
-                return lcmatch( r->required_skills_string(), txt ) || lcmatch( r->skill_used->name(), txt );
+    search_texts.clear();
+    search_texts_generation++;
+}
 
-            case search_type::component:
-                return search_reqs( r->requirements().get_components(), txt );
+const std::string &search_text( const recipe &r, const recipe_subset::search_type key )
+{
+    auto iter = search_texts.find( &r );
+    if( iter == search_texts.end() ) {
+        std::string quality_result;
+        for( const auto &e : item::find_type( r.result )->qualities ) {
+            quality_result += e.first->name;
+            quality_result += '\n';
+        }
+        const std::vector<std::string> texts = {
+            item::nname( r.result ),
+            r.required_skills_string() + '\n' + r.skill_used->name(),
+            reqs_text( r.requirements().get_components() ),
+            reqs_text( r.requirements().get_tools() ),
+            reqs_text( r.requirements().get_qualities() ),
+            quality_result
+        };
+        iter = search_texts.emplace( &r, std::vector<std::string>() ).first;
+        for( const std::string &e : texts ) {
+            iter->second.push_back( lowercase( e ) );
+        }
+    }
+    return iter->second[ static_cast<size_t>( key ) ];
+}
 
-            case search_type::tool:
-                return search_reqs( r->requirements().get_tools(), txt );
+}
 
-            case search_type::quality:
-                return search_reqs( r->requirements().get_qualities(), txt );
+std::vector<const recipe *> recipe_subset::search( const std::string &txt,
+        const search_type key ) const
+{
+    const std::string language = get_option<std::string>( "USE_LANG" );
+    if( language != search_texts_language ) {
+        clear_search_texts();
+        search_texts_language = language;
+    }
 
-            case search_type::quality_result: {
-                const auto &quals = item::find_type( r->result )->qualities;
-                return std::any_of( quals.begin(), quals.end(), [&]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, txt );
-                } );
-            }
+    const std::string needle = lowercase( txt );
+    // Anything matching the longer query also matches the previous one (e.g. while typing),
+    // so only the previous results need to be checked.
+    const bool narrow = !last_search.query.empty() && last_search.key == key &&
+                        last_search.generation == search_texts_generation &&
+                        needle.find( last_search.query ) != std::string::npos;
+    const std::vector<const recipe *> candidates = narrow ? last_search.results :
+            std::vector<const recipe *>( recipes.begin(), recipes.end() );
 
-            default:
-                return false;
-        }
+    std::vector<const recipe *> res;
+    std::copy_if( candidates.begin(), candidates.end(), std::back_inserter( res ),
+    [&]( const recipe * r ) {
+        return search_text( *r, key ).find( needle ) != std::string::npos;
     } );
 
+    last_search.key = key;
+    last_search.query = needle;
+    last_search.generation = search_texts_generation;
+    last_search.results = res;
     return res;
 }
 
@@ -241,6 +294,9 @@ void recipe_dictionary::finalize()
         }
     }
 
+    // The recipes may have changed since anything was searched
+    clear_search_texts();
+
     // Cache auto-learn recipes
     for( const auto &e : recipe_dict.recipes ) {
         if( e.second.autolearn ) {
@@ -251,6 +307,7 @@ void recipe_dictionary::finalize()
 
 void recipe_dictionary::reset()
 {
+    clear_search_texts();
     recipe_dict.autolearn.clear();
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
@@ -288,6 +345,8 @@ void recipe_subset::include( const recipe *r, int custom_difficulty )
             }
         }
         category[r->category].insert( r );
+        // the previous search results may be missing it now
+        last_search.query.clear();
         // Set the difficulty is it's not the default
         if( custom_difficulty != r->difficulty ) {
             difficulties[r] = custom_difficulty;
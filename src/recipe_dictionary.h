@@ -127,6 +127,7 @@ class recipe_subset
             component.clear();
             category.clear();
             recipes.clear();
+            last_search.query.clear();
         }
 
         std::set<const recipe *>::const_iterator begin() const {
@@ -142,6 +143,15 @@ class recipe_subset
         std::map<const recipe *, int> difficulties;
         std::map<std::string, std::set<const recipe *>> category;
         std::map<itype_id, std::set<const recipe *>> component;
+
+        /** Results of the last @ref search, a longer query only has to look through them. */
+        struct search_result {
+            search_type key = search_type::name;
+            std::string query;
+            int generation = 0;
+            std::vector<const recipe *> results;
+        };
+        mutable search_result last_search;
 };
 
 #endif
@@ -1,25 +1,157 @@
 #include "output.h"
 #include "rng.h"
 #include "game_constants.h"
+#include "json.h"
 #include <stdlib.h>
 #include <random>
 #include <chrono>
+#include <cinttypes>
+#include <cstdio>
 
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+static uint64_t splitmix64( uint64_t &x )
+{
+    uint64_t z = ( x += 0x9E3779B97F4A7C15ULL );
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+void rng_engine::seed( uint64_t seed_value )
+{
+    for( auto &e : s ) {
+        e = splitmix64( seed_value );
+    }
+}
+
+std::string rng_engine::serialize() const
+{
+    char buf[4 * 17];
+    snprintf( buf, sizeof( buf ), "%016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64,
+              s[0], s[1], s[2], s[3] );
+    return buf;
+}
+
+bool rng_engine::deserialize( const std::string &data )
+{
+    std::array<uint64_t, 4> tmp;
+    if( sscanf( data.c_str(), "%" SCNx64 " %" SCNx64 " %" SCNx64 " %" SCNx64,
+                &tmp[0], &tmp[1], &tmp[2], &tmp[3] ) != 4 ) {
+        return false;
+    }
+    // The all zero state is the only one the generator can not leave.
+    if( tmp[0] == 0 && tmp[1] == 0 && tmp[2] == 0 && tmp[3] == 0 ) {
+        return false;
+    }
+    s = tmp;
+    return true;
+}
+
+static const std::array<const char *, static_cast<size_t>( rng_stream::num_streams )> stream_names = {{
+        "general", "mapgen", "combat", "weather", "ai"
+    }
+};
+
+static std::array<rng_engine, static_cast<size_t>( rng_stream::num_streams )> &streams()
+{
+    static std::array<rng_engine, static_cast<size_t>( rng_stream::num_streams )> engines;
+    static bool seeded = false;
+    if( !seeded ) {
+        seeded = true;
+        uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+        for( auto &e : engines ) {
+            e.seed( splitmix64( seed ) );
+        }
+    }
+    return engines;
+}
+
+static thread_local rng_engine *current_engine = nullptr;
+
+rng_engine &rng_get_engine()
+{
+    if( current_engine == nullptr ) {
+        current_engine = &rng_get_engine( rng_stream::general );
+    }
+    return *current_engine;
+}
+
+rng_engine &rng_get_engine( const rng_stream stream )
+{
+    return streams()[static_cast<size_t>( stream )];
+}
+
+void rng_set_seed( uint64_t seed )
+{
+    for( auto &e : streams() ) {
+        e.seed( splitmix64( seed ) );
+    }
+}
+
+uint64_t rng_derive_seed( uint64_t seed, const int x, const int y, const int z )
+{
+    seed ^= static_cast<uint32_t>( x ) * 0x9E3779B97F4A7C15ULL;
+    seed = splitmix64( seed ) ^ static_cast<uint32_t>( y );
+    seed = splitmix64( seed ) ^ static_cast<uint32_t>( z );
+    return splitmix64( seed );
+}
+
+unsigned int rng_bits()
+{
+    return rng_get_engine()() >> 32;
+}
+
+void rng_serialize_streams( JsonOut &jsout )
+{
+    jsout.start_object();
+    for( size_t i = 0; i < stream_names.size(); i++ ) {
+        jsout.member( stream_names[i], streams()[i].serialize() );
+    }
+    jsout.end_object();
+}
+
+void rng_deserialize_streams( JsonObject &jo )
+{
+    for( size_t i = 0; i < stream_names.size(); i++ ) {
+        // Streams missing from older saves keep their current state.
+        if( jo.has_string( stream_names[i] ) &&
+            !streams()[i].deserialize( jo.get_string( stream_names[i] ) ) ) {
+            jo.throw_error( "invalid random engine state", stream_names[i] );
+        }
+    }
+}
+
+rng_stream_scope::rng_stream_scope( const rng_stream stream ) :
+    rng_stream_scope( rng_get_engine( stream ) )
+{
+}
+
+rng_stream_scope::rng_stream_scope( rng_engine &engine ) : previous( &rng_get_engine() )
+{
+    current_engine = &engine;
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+    current_engine = previous;
+}
+
 long rng( long val1, long val2 )
 {
     long minVal = ( val1 < val2 ) ? val1 : val2;
     long maxVal = ( val1 < val2 ) ? val2 : val1;
-    return minVal + long( ( maxVal - minVal + 1 ) * double( rand() / double( RAND_MAX + 1.0 ) ) );
+    const uint64_t range = static_cast<uint64_t>( maxVal ) - static_cast<uint64_t>( minVal ) + 1;
+    // A range of 0 means the full range of long wrapped around.
+    return minVal + static_cast<long>( range == 0 ? rng_get_engine()() : rng_get_engine().bounded( range ) );
 }
 
 double rng_float( double val1, double val2 )
 {
     double minVal = ( val1 < val2 ) ? val1 : val2;
     double maxVal = ( val1 < val2 ) ? val2 : val1;
-    return minVal + ( maxVal - minVal ) * double( rand() ) / double( RAND_MAX + 1.0 );
+    return minVal + ( maxVal - minVal ) * rng_get_engine().uniform01();
 }
 
 bool one_in( int chance )
@@ -35,7 +167,7 @@ bool one_in_improved( double chance )
 
 bool x_in_y( double x, double y )
 {
-    return ( ( double )rand() / RAND_MAX ) <= ( ( double )x / y );
+    return rng_get_engine().uniform01() < x / y;
 }
 
 int dice( int number, int sides )
@@ -94,7 +226,5 @@ double rng_normal( double lo, double hi )
 
 double normal_roll( double mean, double stddev )
 {
-    static std::default_random_engine eng(
-        std::chrono::system_clock::now().time_since_epoch().count() );
-    return std::normal_distribution<double>( mean, stddev )( eng );
+    return std::normal_distribution<double>( mean, stddev )( rng_get_engine() );
 }
@@ -4,7 +4,125 @@
 
 #include "compatibility.h"
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <string>
+
+class JsonObject;
+class JsonOut;
+
+/**
+ * Pseudo random number generator (xoshiro256**), satisfies the UniformRandomBitGenerator
+ * requirements so it can be used with the <random> distributions.
+ */
+class rng_engine
+{
+    public:
+        using result_type = uint64_t;
+
+        explicit rng_engine( uint64_t seed_value = 0 ) {
+            seed( seed_value );
+        }
+        /** Sets the state from @p seed_value (expanded with splitmix64). */
+        void seed( uint64_t seed_value );
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT64_MAX;
+        }
+        result_type operator()() {
+            const uint64_t result = rotl( s[1] * 5, 7 ) * 9;
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl( s[3], 45 );
+            return result;
+        }
+
+        /** Uniformly distributed in [0, @p range), @p range must not be 0. */
+        uint64_t bounded( uint64_t range ) {
+            if( range <= UINT32_MAX ) {
+                // Multiply-shift instead of modulo: no division and no branch on the value.
+                return ( ( *this )() >> 32 ) * range >> 32;
+            }
+            return ( *this )() % range;
+        }
+        /** Uniformly distributed in [0, 1). */
+        double uniform01() {
+            return ( ( *this )() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+        }
+
+        /** State as hex string, for savegames. */
+        std::string serialize() const;
+        /** Restores a state written by @ref serialize, returns false if it is malformed. */
+        bool deserialize( const std::string &data );
+
+        bool operator==( const rng_engine &rhs ) const {
+            return s == rhs.s;
+        }
+
+    private:
+        static uint64_t rotl( const uint64_t x, const int k ) {
+            return ( x << k ) | ( x >> ( 64 - k ) );
+        }
+
+        std::array<uint64_t, 4> s;
+};
+
+/**
+ * Independent random streams, so one subsystem drawing more or fewer numbers does not
+ * change what the others get.
+ */
+enum class rng_stream : int {
+    general = 0,
+    mapgen,
+    combat,
+    weather,
+    ai,
+    num_streams
+};
+
+/**
+ * Engine used by @ref rng and friends on the calling thread: the engine of the innermost
+ * @ref rng_stream_scope, otherwise the @ref rng_stream::general stream.
+ * Threads other than the main thread must set up their own engine with a scope.
+ */
+rng_engine &rng_get_engine();
+/** Engine of the given stream. */
+rng_engine &rng_get_engine( rng_stream stream );
+/** Seeds all streams, each with a different seed derived from @p seed. */
+void rng_set_seed( uint64_t seed );
+/** Seed for a local engine, derived from @p seed and a position (e.g. of a submap). */
+uint64_t rng_derive_seed( uint64_t seed, int x, int y, int z );
+/** 32 random bits from the current engine, replacement for rand(). */
+unsigned int rng_bits();
+
+/** Saves and restores the state of all streams (see game::serialize). */
+void rng_serialize_streams( JsonOut &jsout );
+void rng_deserialize_streams( JsonObject &jo );
+
+/**
+ * Makes @ref rng and friends draw from another engine until the scope is left.
+ * Scopes can be nested.
+ */
+class rng_stream_scope
+{
+    public:
+        explicit rng_stream_scope( rng_stream stream );
+        explicit rng_stream_scope( rng_engine &engine );
+        ~rng_stream_scope();
+
+        rng_stream_scope( const rng_stream_scope & ) = delete;
+        rng_stream_scope &operator=( const rng_stream_scope & ) = delete;
+    private:
+        rng_engine *previous;
+};
 
 long rng( long val1, long val2 );
 double rng_float( double val1, double val2 );
@@ -0,0 +1,238 @@
+#include "save_writer.h"
+
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "mapsharing.h"
+#include "output.h"
+#include "translations.h"
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// libstdc++ builds without thread support (e.g. MinGW with win32 threads) have no std::mutex.
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_HAS_GTHREADS)
+#define SAVE_WRITER_SYNCHRONOUS
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace
+{
+
+struct write_job {
+    std::string path;
+    std::string content;
+};
+
+struct write_error {
+    std::string path;
+    std::string what;
+};
+
+/** Writes to a temporary file and moves that over @p job.path, throws on failure. */
+void write_file( const write_job &job )
+{
+    const std::string temp_path = job.path + ".temp";
+    std::ofstream fout( temp_path.c_str(), std::ios::binary );
+    if( !fout.is_open() ) {
+        throw std::runtime_error( "opening file failed" );
+    }
+    fout.write( job.content.data(), job.content.size() );
+    fout.close();
+    if( fout.fail() ) {
+        remove_file( temp_path );
+        throw std::runtime_error( "writing to file failed" );
+    }
+    if( !rename_file( temp_path, job.path ) ) {
+        remove_file( temp_path );
+        throw std::runtime_error( "replacing the file failed" );
+    }
+}
+
+void write_file_exclusive( const write_job &job )
+{
+    ofstream_wrapper_exclusive fout( job.path );
+    fout.stream().write( job.content.data(), job.content.size() );
+    fout.close();
+}
+
+#ifdef SAVE_WRITER_SYNCHRONOUS
+
+std::vector<write_error> errors;
+
+#else
+
+class writer_pool
+{
+    public:
+        ~writer_pool() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            job_added.notify_all();
+            // Workers finish the queue before they stop, so everything saved gets written.
+            for( auto &worker : workers ) {
+                worker.join();
+            }
+        }
+
+        void add( write_job &&job ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                const auto queued = std::find_if( queue.begin(), queue.end(), [&job]( const write_job & j ) {
+                    return j.path == job.path;
+                } );
+                if( queued != queue.end() ) {
+                    queued->content = std::move( job.content );
+                    return;
+                }
+                queue.push_back( std::move( job ) );
+                if( workers.size() < max_workers() ) {
+                    workers.emplace_back( &writer_pool::work, this );
+                }
+            }
+            job_added.notify_one();
+        }
+
+        void wait_for( const std::string &path ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [this, &path]() {
+                return active.count( path ) == 0 &&
+                std::none_of( queue.begin(), queue.end(), [&path]( const write_job & j ) {
+                    return j.path == path;
+                } );
+            } );
+        }
+
+        void wait_all() {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [this]() {
+                return queue.empty() && active.empty();
+            } );
+        }
+
+        std::vector<write_error> take_errors() {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::vector<write_error> result;
+            result.swap( errors );
+            return result;
+        }
+
+    private:
+        static size_t max_workers() {
+            return std::max( 1u, std::min( 4u, std::thread::hardware_concurrency() ) );
+        }
+
+        void work() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                // Writes of the same file must not overlap, they share the temporary file.
+                const auto next = std::find_if( queue.begin(), queue.end(), [this]( const write_job & j ) {
+                    return active.count( j.path ) == 0;
+                } );
+                if( next == queue.end() ) {
+                    if( stopping && queue.empty() ) {
+                        return;
+                    }
+                    job_added.wait( lock );
+                    continue;
+                }
+                const write_job job = std::move( *next );
+                queue.erase( next );
+                active.insert( job.path );
+                lock.unlock();
+
+                std::string what;
+                try {
+                    write_file( job );
+                } catch( const std::exception &err ) {
+                    what = err.what();
+                }
+
+                lock.lock();
+                active.erase( job.path );
+                if( !what.empty() ) {
+                    errors.push_back( write_error{ job.path, what } );
+                }
+                job_done.notify_all();
+                // A write of the same file may have been waiting for this one.
+                job_added.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable job_added;
+        std::condition_variable job_done;
+        std::list<write_job> queue;
+        std::set<std::string> active;
+        std::vector<write_error> errors;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+};
+
+writer_pool &get_pool()
+{
+    static writer_pool pool;
+    return pool;
+}
+
+#endif
+
+} // namespace
+
+void save_writer::write( const std::string &path, std::string content )
+{
+    write_job job{ path, std::move( content ) };
+    if( MAP_SHARING::isSharing() ) {
+        wait_for( path );
+        write_file_exclusive( job );
+        return;
+    }
+#ifdef SAVE_WRITER_SYNCHRONOUS
+    try {
+        write_file( job );
+    } catch( const std::exception &err ) {
+        errors.push_back( write_error{ path, err.what() } );
+    }
+#else
+    get_pool().add( std::move( job ) );
+#endif
+}
+
+void save_writer::wait_for( const std::string &path )
+{
+#ifdef SAVE_WRITER_SYNCHRONOUS
+    ( void )path;
+#else
+    get_pool().wait_for( path );
+#endif
+}
+
+bool save_writer::wait()
+{
+#ifndef SAVE_WRITER_SYNCHRONOUS
+    get_pool().wait_all();
+#endif
+    return report_errors();
+}
+
+bool save_writer::report_errors()
+{
+#ifdef SAVE_WRITER_SYNCHRONOUS
+    std::vector<write_error> failed;
+    failed.swap( errors );
+#else
+    const std::vector<write_error> failed = get_pool().take_errors();
+#endif
+    for( const auto &err : failed ) {
+        popup( _( "Failed to write \"%1$s\": %2$s" ), err.path.c_str(), err.what.c_str() );
+    }
+    return failed.empty();
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SAVE_WRITER_H
+#define SAVE_WRITER_H
+
+#include <string>
+
+/**
+ * Writes save files on background threads.
+ *
+ * The content of a file is serialized on the main thread (the game state is not thread
+ * safe), but opening, writing and closing the file happens on a small pool of worker
+ * threads, so the game can continue while a large save reaches the disk. Each file is
+ * first written to "<path>.temp", which then replaces the file, so a crash during the
+ * write leaves the previous version intact.
+ *
+ * Reading a file through @ref read_from_file (and friends) waits for its pending write,
+ * code that looks at save files in another way must call @ref save_writer::wait_for or
+ * @ref save_writer::wait first.
+ *
+ * With map sharing enabled, files are written right away with the exclusive I/O
+ * functions, as the lock files they use are not thread safe.
+ */
+namespace save_writer
+{
+/**
+ * Queues @p content to be written to @p path. A write of the same path that has not
+ * started yet is replaced by this one.
+ * May throw if the file is written right away (see above) and that fails.
+ */
+void write( const std::string &path, std::string content );
+/** Blocks until the pending write of @p path (if any) is finished. */
+void wait_for( const std::string &path );
+/**
+ * Blocks until all pending writes are finished, then reports the failed ones.
+ * @return Whether all writes since the last report succeeded.
+ */
+bool wait();
+/**
+ * Shows a popup for each write that failed since the last report, does not block.
+ * Must be called from the main thread.
+ * @return Whether there was no failure to report.
+ */
+bool report_errors();
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "mongroup.h"
 #include "scent_map.h"
 #include "io.h"
+#include "rng.h"
 
 #include <map>
 #include <set>
@@ -108,6 +109,9 @@ void game::serialize(std::ostream & fout) {
         json.member( "player", u );
         Messages::serialize( json );
 
+        json.member( "rng" );
+        rng_serialize_streams( json );
+
         json.end_object();
 }
 
@@ -247,6 +251,11 @@ void game::unserialize(std::istream & fin)
         data.read("player", u);
         Messages::deserialize( data );
 
+        if( data.has_object( "rng" ) ) {
+            JsonObject rng_data = data.get_object( "rng" );
+            rng_deserialize_streams( rng_data );
+        }
+
 #ifdef __ANDROID__
         // This is a duplicate of game::load_shortcuts() logic, here for legacy save game loading support.
         // Allow reading of old shortcut persistence data from .sav files.
@@ -701,16 +710,219 @@ void overmap::load_legacy_monstergroups( JsonIn &jsin )
     }
 }
 
+/*
+ * Overmap files since version 27 start with binary terrain layers (and overmap views with
+ * binary visible/explored planes) after the version line, followed by the remaining data as
+ * JSON. Integers are stored as little endian base 128 varints.
+ */
+static const int first_overmap_binary_version = 27;
+static const int overmap_cells = OMAPX * OMAPY;
+
+static void write_varint( std::ostream &fout, unsigned int value )
+{
+    while( value >= 0x80 ) {
+        fout.put( static_cast<char>( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+    fout.put( static_cast<char>( value ) );
+}
+
+static void write_bytes( std::ostream &fout, const std::string &bytes )
+{
+    write_varint( fout, bytes.size() );
+    fout.write( bytes.data(), bytes.size() );
+}
+
+// throws std::exception
+static unsigned int read_varint( std::istream &fin )
+{
+    unsigned int value = 0;
+    for( int shift = 0; shift < 32; shift += 7 ) {
+        const int c = fin.get();
+        if( c == EOF ) {
+            throw std::runtime_error( "unexpected end of binary overmap data" );
+        }
+        value |= static_cast<unsigned int>( c & 0x7f ) << shift;
+        if( ( c & 0x80 ) == 0 ) {
+            return value;
+        }
+    }
+    throw std::runtime_error( "malformed number in binary overmap data" );
+}
+
+// throws std::exception
+static unsigned int read_varint( const std::string &bytes, size_t &pos )
+{
+    unsigned int value = 0;
+    for( int shift = 0; shift < 32 && pos < bytes.size(); shift += 7 ) {
+        const unsigned char c = bytes[pos++];
+        value |= static_cast<unsigned int>( c & 0x7f ) << shift;
+        if( ( c & 0x80 ) == 0 ) {
+            return value;
+        }
+    }
+    throw std::runtime_error( "malformed number in binary overmap data" );
+}
+
+// throws std::exception
+static std::string read_bytes( std::istream &fin )
+{
+    const unsigned int size = read_varint( fin );
+    std::string bytes( size, '\0' );
+    if( size > 0 && !fin.read( &bytes[0], size ) ) {
+        throw std::runtime_error( "unexpected end of binary overmap data" );
+    }
+    return bytes;
+}
+
+/**
+ * Calls @p run( index, first, count ) for each run of a packed terrain layer, @p first is
+ * the index of its first cell (x + y * OMAPX).
+ * throws std::exception
+ */
+template<typename RunFunc>
+static void for_each_terrain_run( const std::string &packed, const size_t table_size, RunFunc run )
+{
+    size_t pos = 0;
+    int first = 0;
+    while( first < overmap_cells ) {
+        const unsigned int index = read_varint( packed, pos );
+        const unsigned int count = read_varint( packed, pos );
+        if( index >= table_size || count == 0 || count > static_cast<unsigned int>( overmap_cells - first ) ) {
+            throw std::runtime_error( "malformed terrain run in binary overmap data" );
+        }
+        run( index, first, count );
+        first += count;
+    }
+}
+
+void overmap::unpack_terrain( const int z ) const
+{
+    std::string packed;
+    packed.swap( packed_terrain[z] );
+    // The terrain is logically part of the (const) overmap, it's just stored compactly until needed.
+    auto &terrain = const_cast<overmap *>( this )->layer[z].terrain;
+    try {
+        for_each_terrain_run( packed, packed_terrain_table.size(),
+        [&]( const unsigned int index, const int first, const unsigned int count ) {
+            const oter_id &t = packed_terrain_table[index];
+            for( int c = first; c < first + static_cast<int>( count ); c++ ) {
+                terrain[c % OMAPX][c / OMAPX] = t;
+            }
+        } );
+    } catch( const std::exception &err ) {
+        debugmsg( "Failed to load the terrain of overmap %d,%d: %s", loc.x, loc.y, err.what() );
+    }
+}
+
+// throws std::exception
+void overmap::unserialize_terrain( std::istream &fin )
+{
+    const unsigned int table_size = read_varint( fin );
+    std::vector<std::string> names;
+    packed_terrain_table.clear();
+    bool has_obsolete = false;
+    for( unsigned int i = 0; i < table_size; i++ ) {
+        names.push_back( read_bytes( fin ) );
+        const std::string &name = names.back();
+        if( obsolete_terrain( name ) ) {
+            has_obsolete = true;
+            packed_terrain_table.push_back( oter_id( 0 ) );
+        } else if( oter_str_id( name ).is_valid() ) {
+            packed_terrain_table.push_back( oter_id( name ) );
+        } else {
+            debugmsg( "Loaded bad ter! ter %s", name.c_str() );
+            packed_terrain_table.push_back( oter_id( 0 ) );
+        }
+    }
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        packed_terrain[z] = read_bytes( fin );
+    }
+    if( !has_obsolete ) {
+        return;
+    }
+    // Obsolete terrain is converted based on its surroundings, which needs everything decoded.
+    std::unordered_map<tripoint, std::string> needs_conversion;
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        for_each_terrain_run( packed_terrain[z], names.size(),
+        [&]( const unsigned int index, const int first, const unsigned int count ) {
+            if( obsolete_terrain( names[index] ) ) {
+                for( int c = first; c < first + static_cast<int>( count ); c++ ) {
+                    needs_conversion.emplace( tripoint( c % OMAPX, c / OMAPX, z - OVERMAP_DEPTH ), names[index] );
+                }
+            }
+        } );
+        unpack_terrain( z );
+    }
+    convert_terrain( needs_conversion );
+}
+
+void overmap::serialize_terrain( std::ostream &fout ) const
+{
+    // Layers that are still packed are written as they are, so the table they refer to goes
+    // first. Decoded layers add the terrain types that aren't in it yet.
+    std::vector<oter_id> table;
+    if( std::any_of( packed_terrain.begin(), packed_terrain.end(), []( const std::string & packed ) {
+        return !packed.empty();
+    } ) ) {
+        table = packed_terrain_table;
+    }
+    std::unordered_map<oter_id, unsigned int> table_index;
+    for( size_t i = 0; i < table.size(); i++ ) {
+        table_index.emplace( table[i], i );
+    }
+
+    std::array<std::string, OVERMAP_LAYERS> packed_layers;
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        if( !packed_terrain[z].empty() ) {
+            packed_layers[z] = packed_terrain[z];
+            continue;
+        }
+        std::ostringstream layer_out;
+        const auto write_run = [&]( const oter_id &t, const int count ) {
+            const auto iter = table_index.emplace( t, table.size() ).first;
+            if( iter->second == table.size() ) {
+                table.push_back( t );
+            }
+            write_varint( layer_out, iter->second );
+            write_varint( layer_out, count );
+        };
+        oter_id last = layer[z].terrain[0][0];
+        int count = 0;
+        for( int j = 0; j < OMAPY; j++ ) {
+            for( int i = 0; i < OMAPX; i++ ) {
+                const oter_id &t = layer[z].terrain[i][j];
+                if( t != last ) {
+                    write_run( last, count );
+                    last = t;
+                    count = 0;
+                }
+                count++;
+            }
+        }
+        write_run( last, count );
+        packed_layers[z] = layer_out.str();
+    }
+
+    write_varint( fout, table.size() );
+    for( const oter_id &t : table ) {
+        write_bytes( fout, t.id().str() );
+    }
+    for( const std::string &packed : packed_layers ) {
+        write_bytes( fout, packed );
+    }
+}
+
 // throws std::exception
 void overmap::unserialize( std::istream &fin ) {
 
+    int savedver = -1;
     if ( fin.peek() == '#' ) {
         // This was the last savegame version that produced the old format.
         static int overmap_legacy_save_version = 24;
         std::string vline;
         getline(fin, vline);
         std::string tmphash, tmpver;
-        int savedver = -1;
         std::stringstream vliness(vline);
         vliness >> tmphash >> tmpver >> savedver;
         if( savedver <= overmap_legacy_save_version  ) {
@@ -718,6 +930,9 @@ void overmap::unserialize( std::istream &fin ) {
             return;
         }
     }
+    if( savedver >= first_overmap_binary_version ) {
+        unserialize_terrain( fin );
+    }
 
     JsonIn jsin( fin );
     jsin.start_object();
@@ -916,17 +1131,67 @@ static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool (&arra
     }
 }
 
+enum class packed_plane : char {
+    all_false = 0,
+    all_true,
+    bits,
+};
+
+/** Writes a plane as one bit per cell, or as a single byte if all cells are the same. */
+static void write_plane( std::ostream &fout, const bool (&array)[OMAPX][OMAPY] )
+{
+    int set = 0;
+    std::string bits( ( overmap_cells + 7 ) / 8, '\0' );
+    for( int c = 0; c < overmap_cells; c++ ) {
+        if( array[c % OMAPX][c / OMAPX] ) {
+            bits[c / 8] |= 1 << ( c % 8 );
+            set++;
+        }
+    }
+    if( set == 0 ) {
+        fout.put( static_cast<char>( packed_plane::all_false ) );
+    } else if( set == overmap_cells ) {
+        fout.put( static_cast<char>( packed_plane::all_true ) );
+    } else {
+        fout.put( static_cast<char>( packed_plane::bits ) );
+        fout.write( bits.data(), bits.size() );
+    }
+}
+
+// throws std::exception
+static void read_plane( std::istream &fin, bool (&array)[OMAPX][OMAPY] )
+{
+    const int type = fin.get();
+    if( type == static_cast<int>( packed_plane::all_false ) ||
+        type == static_cast<int>( packed_plane::all_true ) ) {
+        const bool value = type == static_cast<int>( packed_plane::all_true );
+        for( int c = 0; c < overmap_cells; c++ ) {
+            array[c % OMAPX][c / OMAPX] = value;
+        }
+        return;
+    } else if( type != static_cast<int>( packed_plane::bits ) ) {
+        throw std::runtime_error( "malformed plane in binary overmap data" );
+    }
+    std::string bits( ( overmap_cells + 7 ) / 8, '\0' );
+    if( !fin.read( &bits[0], bits.size() ) ) {
+        throw std::runtime_error( "unexpected end of binary overmap data" );
+    }
+    for( int c = 0; c < overmap_cells; c++ ) {
+        array[c % OMAPX][c / OMAPX] = ( bits[c / 8] >> ( c % 8 ) ) & 1;
+    }
+}
+
 // throws std::exception
 void overmap::unserialize_view(std::istream &fin)
 {
     // Private/per-character view of the overmap.
+    int savedver = -1;
     if ( fin.peek() == '#' ) {
         // This was the last savegame version that produced the old format.
         static int overmap_legacy_save_version = 24;
         std::string vline;
         getline(fin, vline);
         std::string tmphash, tmpver;
-        int savedver = -1;
         std::stringstream vliness(vline);
         vliness >> tmphash >> tmpver >> savedver;
         if( savedver <= overmap_legacy_save_version  ) {
@@ -934,6 +1199,14 @@ void overmap::unserialize_view(std::istream &fin)
             return;
         }
     }
+    if( savedver >= first_overmap_binary_version ) {
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            read_plane( fin, layer[z].visible );
+        }
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            read_plane( fin, layer[z].explored );
+        }
+    }
 
     JsonIn jsin( fin );
     jsin.start_object();
@@ -975,57 +1248,20 @@ void overmap::unserialize_view(std::istream &fin)
     }
 }
 
-static void serialize_array_to_compacted_sequence( JsonOut &json, const bool (&array)[OMAPX][OMAPY] ) {
-    int count = 0;
-    int lastval = -1;
-    for( int j = 0; j < OMAPY; j++ ) {
-        for( int i = 0; i < OMAPX; i++ ) {
-            int value = array[i][j];
-            if( value != lastval ) {
-                if (count) {
-                    json.write(count);
-                    json.end_array();
-                }
-                lastval = value;
-                json.start_array();
-                json.write( (bool)value );
-                count = 1;
-            } else {
-                count++;
-            }
-        }
-    }
-    json.write(count);
-    json.end_array();
-}
-
 void overmap::serialize_view( std::ostream &fout ) const
 {
-    static const int first_overmap_view_json_version = 25;
-    fout << "# version " << first_overmap_view_json_version << std::endl;
+    fout << "# version " << first_overmap_binary_version << std::endl;
 
-    JsonOut json(fout, false);
-    json.start_object();
-
-    json.member("visible");
-    json.start_array();
-    for (int z = 0; z < OVERMAP_LAYERS; ++z) {
-        json.start_array();
-        serialize_array_to_compacted_sequence( json, layer[z].visible );
-        json.end_array();
-        fout << std::endl;
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        write_plane( fout, layer[z].visible );
     }
-    json.end_array();
-
-    json.member("explored");
-    json.start_array();
-    for (int z = 0; z < OVERMAP_LAYERS; ++z) {
-        json.start_array();
-        serialize_array_to_compacted_sequence( json, layer[z].explored );
-        json.end_array();
-        fout << std::endl;
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        write_plane( fout, layer[z].explored );
     }
-    json.end_array();
+    fout << std::endl;
+
+    JsonOut json(fout, false);
+    json.start_object();
 
     json.member("notes");
     json.start_array();
@@ -1113,45 +1349,14 @@ void overmap::save_monster_groups( JsonOut &jout ) const
 
 void overmap::serialize( std::ostream &fout ) const
 {
-    static const int first_overmap_json_version = 26;
-    fout << "# version " << first_overmap_json_version << std::endl;
+    fout << "# version " << first_overmap_binary_version << std::endl;
+
+    serialize_terrain( fout );
+    fout << std::endl;
 
     JsonOut json(fout, false);
     json.start_object();
 
-    json.member("layers");
-    json.start_array();
-    for (int z = 0; z < OVERMAP_LAYERS; ++z) {
-        int count = 0;
-        oter_id last_tertype(-1);
-        json.start_array();
-        for (int j = 0; j < OMAPY; j++) {
-            for (int i = 0; i < OMAPX; i++) {
-                oter_id t = layer[z].terrain[i][j];
-                if (t != last_tertype) {
-                    if (count) {
-                        json.write(count);
-                        json.end_array();
-                    }
-                    last_tertype = t;
-                    json.start_array();
-                    json.write( t.id() );
-                    count = 1;
-                } else {
-                    count++;
-                }
-            }
-        }
-        json.write(count);
-        // End the last entry for a z-level.
-        json.end_array();
-        // End the z-level
-        json.end_array();
-        // Insert a newline occasionally so the file isn't totally unreadable.
-        fout << std::endl;
-    }
-    json.end_array();
-
     // temporary, to allow user to manually switch regions during play until regionmap is done.
     json.member("region_id", settings.id);
     fout << std::endl;
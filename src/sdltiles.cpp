@@ -158,10 +158,11 @@ public:
     void load_font(std::string typeface, int fontsize);
     virtual void OutputChar(std::string ch, int x, int y, unsigned char color);
 protected:
-    SDL_Texture *create_glyph(const std::string &ch, int color);
+    /** Renders the glyph into a new surface (owned by the caller) of the size of a cell. */
+    SDL_Surface *create_glyph(const std::string &ch, int color);
 
     TTF_Font* font;
-    // Maps (character code, color) to SDL_Texture*
+    // Maps (character code, color) to the area of a glyph atlas the glyph is drawn from
 
     struct key_t {
         std::string   codepoints;
@@ -175,10 +176,22 @@ protected:
 
     struct cached_t {
         SDL_Texture* texture;
+        SDL_Rect     src;
         int          width;
     };
 
+    /**
+     * Copies the glyph surface into the current glyph atlas (starting a new one if
+     * it is full) and returns where it has been placed.
+     */
+    cached_t add_to_atlas(SDL_Surface *glyph);
+
     std::map<key_t, cached_t> glyph_cache_map;
+    // Textures the glyphs are packed into, row by row. Only the last one gets new glyphs.
+    std::vector<SDL_Texture*> glyph_atlases;
+    // Position of the next glyph in the last atlas.
+    int atlas_x;
+    int atlas_y;
 };
 
 /**
@@ -401,6 +414,12 @@ bool WinCreate()
         return false;
     }
 
+#ifdef SDL_HINT_RENDER_BATCHING
+    // Consecutive copies from the same tileset / glyph atlas texture can then be merged
+    // into a single draw call by the renderer.
+    SDL_SetHint( SDL_HINT_RENDER_BATCHING, "1" );
+#endif
+
     bool software_renderer = get_option<bool>( "SOFTWARE_RENDERING" );
     if( !software_renderer ) {
         dbg( D_INFO ) << "Attempting to initialize accelerated SDL renderer.";
@@ -585,7 +604,7 @@ inline void FillRectDIB(int x, int y, int width, int height, unsigned char color
 }
 
 
-SDL_Texture *CachedTTFFont::create_glyph(const std::string &ch, int color)
+SDL_Surface *CachedTTFFont::create_glyph(const std::string &ch, int color)
 {
     SDL_Surface * sglyph = (fontblending ? TTF_RenderUTF8_Blended : TTF_RenderUTF8_Solid)(font, ch.c_str(), windowsPalette[color]);
     if (sglyph == NULL) {
@@ -612,9 +631,7 @@ SDL_Texture *CachedTTFFont::create_glyph(const std::string &ch, int color)
                                                 rmask, gmask, bmask, amask);
     if (surface == NULL) {
         dbg( D_ERROR ) << "CreateRGBSurface failed: " << SDL_GetError();
-        SDL_Texture *glyph = SDL_CreateTextureFromSurface(renderer, sglyph);
-        SDL_FreeSurface(sglyph);
-        return glyph;
+        return sglyph;
     }
     SDL_Rect src_rect = { 0, 0, sglyph->w, sglyph->h };
     SDL_Rect dst_rect = { 0, 0, fontwidth * wf, fontheight };
@@ -640,10 +657,62 @@ SDL_Texture *CachedTTFFont::create_glyph(const std::string &ch, int color)
         SDL_FreeSurface(sglyph);
         sglyph = surface;
     }
+    return sglyph;
+}
+
+CachedTTFFont::cached_t CachedTTFFont::add_to_atlas(SDL_Surface *const glyph)
+{
+    cached_t result { nullptr, { 0, 0, glyph->w, glyph->h }, 0 };
+    // Same pixel layout as the atlas textures, so the pixels can be uploaded directly.
+    SDL_Surface *const converted = SDL_ConvertSurfaceFormat(glyph, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (converted == NULL) {
+        dbg( D_ERROR ) << "SDL_ConvertSurfaceFormat failed: " << SDL_GetError();
+        return result;
+    }
+
+    SDL_RendererInfo info;
+    int atlas_width = 1024;
+    int atlas_height = 1024;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        if (info.max_texture_width > 0) {
+            atlas_width = std::min(atlas_width, info.max_texture_width);
+        }
+        if (info.max_texture_height > 0) {
+            atlas_height = std::min(atlas_height, info.max_texture_height);
+        }
+    }
+    atlas_width = std::max(atlas_width, converted->w);
+    atlas_height = std::max(atlas_height, converted->h);
+
+    if (!glyph_atlases.empty() && atlas_x + converted->w > atlas_width) {
+        // Start the next row, all glyphs are one cell high.
+        atlas_x = 0;
+        atlas_y += fontheight;
+    }
+    if (glyph_atlases.empty() || atlas_y + converted->h > atlas_height) {
+        SDL_Texture *const atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                     SDL_TEXTUREACCESS_STATIC, atlas_width, atlas_height);
+        if (atlas == NULL) {
+            dbg( D_ERROR ) << "SDL_CreateTexture failed: " << SDL_GetError();
+            SDL_FreeSurface(converted);
+            return result;
+        }
+        SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+        glyph_atlases.push_back(atlas);
+        atlas_x = 0;
+        atlas_y = 0;
+    }
 
-    SDL_Texture *glyph = SDL_CreateTextureFromSurface(renderer, sglyph);
-    SDL_FreeSurface(sglyph);
-    return glyph;
+    result.src.x = atlas_x;
+    result.src.y = atlas_y;
+    if (SDL_UpdateTexture(glyph_atlases.back(), &result.src, converted->pixels, converted->pitch) != 0) {
+        dbg( D_ERROR ) << "SDL_UpdateTexture failed: " << SDL_GetError();
+    } else {
+        result.texture = glyph_atlases.back();
+        atlas_x += converted->w;
+    }
+    SDL_FreeSurface(converted);
+    return result;
 }
 
 void CachedTTFFont::OutputChar(std::string ch, int const x, int const y, unsigned char const color)
@@ -655,7 +724,13 @@ void CachedTTFFont::OutputChar(std::string ch, int const x, int const y, unsigne
     if (it != std::end(glyph_cache_map) && !glyph_cache_map.key_comp()(key, it->first)) {
         value = it->second;
     } else {
-        value.texture = create_glyph(key.codepoints, key.color);
+        SDL_Surface *const glyph = create_glyph(key.codepoints, key.color);
+        if (glyph != NULL) {
+            value = add_to_atlas(glyph);
+            SDL_FreeSurface(glyph);
+        } else {
+            value.texture = nullptr;
+        }
         value.width = fontwidth * utf8_wrapper(key.codepoints).display_width();
         glyph_cache_map.insert(it, std::make_pair(std::move(key), value));
     }
@@ -669,7 +744,7 @@ void CachedTTFFont::OutputChar(std::string ch, int const x, int const y, unsigne
     if (opacity != 1.0f)
         SDL_SetTextureAlphaMod(value.texture, opacity * 255.0f);
 #endif
-    if (SDL_RenderCopy( renderer, value.texture, nullptr, &rect)) {
+    if (SDL_RenderCopy( renderer, value.texture, &value.src, &rect)) {
         dbg(D_ERROR) << "SDL_RenderCopy failed: " << SDL_GetError();
     }
 #ifdef __ANDROID__
@@ -1145,18 +1220,24 @@ bool Font::draw_window( WINDOW *win, int offsetx, int offsety )
         }
     }
 
-    // @todo Get this from UTF system to make sure it is exactly the kind of space we need
-    static const std::string space_string = " ";
-
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
-        if( !win->line[j].touched ) {
+        curseline &line = win->line[j];
+        if( !line.touched ) {
             continue;
         }
         update = true;
-        win->line[j].touched = false;
-        for( int i = 0; i < win->width; i++ ) {
-            const cursecell &cell = win->line[j].chars[i];
+        // Cells outside of the dirty range are unchanged and already in the framebuffer,
+        // unless a different window (or zoom level) has been drawn there in the meantime.
+        int first = 0;
+        int last = win->width;
+        if( oldWinCompatible && fontScale == fontScaleBuffer ) {
+            first = std::max( 0, line.dirty_begin );
+            last = std::min( win->width, line.dirty_end );
+        }
+        line.untouch();
+        for( int i = first; i < last; i++ ) {
+            const cursecell &cell = line.chars[i];
 
             const int drawx = offsetx + i * fontwidth;
             const int drawy = offsety + j * fontheight;
@@ -1185,31 +1266,32 @@ bool Font::draw_window( WINDOW *win, int offsetx, int offsety )
             }
             oldcell = cell;
 
-            if( cell.ch.empty() ) {
+            if( cell.empty() ) {
                 continue; // second cell of a multi-cell character
             }
 
             // Spaces are used a lot, so this does help noticeably
-            if( cell.ch == space_string ) {
+            if( cell.glyph == ' ' ) {
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, cell.BG );
                 continue;
             }
-            const char *utf8str = cell.ch.c_str();
-            int len = cell.ch.length();
+            const std::string &ch = cell.ch();
+            const char *utf8str = ch.c_str();
+            int len = ch.length();
             const int codepoint = UTF8_getch( &utf8str, &len );
             const int FG = cell.FG;
             const int BG = cell.BG;
             if( codepoint != UNKNOWN_UNICODE ) {
-                const int cw = utf8_width( cell.ch );
+                const int cw = utf8_width( ch );
                 if( cw < 1 ) {
                     // utf8_width() may return a negative width
                     continue;
                 }
                 FillRectDIB( drawx, drawy, fontwidth * cw, fontheight, BG );
-                OutputChar( cell.ch, drawx, drawy, FG );
+                OutputChar( ch, drawx, drawy, FG );
             } else {
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
-                draw_ascii_lines( static_cast<unsigned char>( cell.ch[0] ), drawx, drawy, FG );
+                draw_ascii_lines( static_cast<unsigned char>( ch[0] ), drawx, drawy, FG );
             }
 
         }
@@ -3469,6 +3551,8 @@ void BitmapFont::draw_ascii_lines(unsigned char line_id, int drawx, int drawy, i
 CachedTTFFont::CachedTTFFont(int w, int h)
 : Font(w, h)
 , font(NULL)
+, atlas_x(0)
+, atlas_y(0)
 {
 }
 
@@ -3483,11 +3567,10 @@ void CachedTTFFont::clear()
         TTF_CloseFont(font);
         font = NULL;
     }
-    for( auto &a : glyph_cache_map ) {
-        if( a.second.texture ) {
-            SDL_DestroyTexture( a.second.texture );
-        }
+    for( auto &a : glyph_atlases ) {
+        SDL_DestroyTexture( a );
     }
+    glyph_atlases.clear();
     glyph_cache_map.clear();
 }
 
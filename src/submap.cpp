@@ -14,7 +14,6 @@ submap::submap()
     std::uninitialized_fill_n( &frn[0][0], elements, f_null );
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
     std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
-    std::uninitialized_fill_n( &rad[0][0], elements, 0 );
 
     is_uniform = false;
 }
@@ -34,16 +33,34 @@ void submap::delete_vehicles()
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 
+void submap::compact()
+{
+    itm.erase_if( []( const std::list<item> &items ) {
+        return items.empty();
+    } );
+    fld.erase_if( []( const field &f ) {
+        return f.fieldCount() == 0;
+    } );
+    cosmetics.erase_if( []( const std::map<std::string, std::string> &c ) {
+        return c.empty();
+    } );
+}
+
 bool submap::has_graffiti( int x, int y ) const
 {
-    return cosmetics[x][y].count( COSMETICS_GRAFFITI ) > 0;
+    const auto *const c = cosmetics.find( x, y );
+    return c != nullptr && c->count( COSMETICS_GRAFFITI ) > 0;
 }
 
 const std::string &submap::get_graffiti( int x, int y ) const
 {
-    const auto it = cosmetics[x][y].find( COSMETICS_GRAFFITI );
-    if( it == cosmetics[x][y].end() ) {
-        static const std::string empty_string;
+    static const std::string empty_string;
+    const auto *const c = cosmetics.find( x, y );
+    if( c == nullptr ) {
+        return empty_string;
+    }
+    const auto it = c->find( COSMETICS_GRAFFITI );
+    if( it == c->end() ) {
         return empty_string;
     }
     return it->second;
@@ -52,11 +69,16 @@ const std::string &submap::get_graffiti( int x, int y ) const
 void submap::set_graffiti( int x, int y, const std::string &new_graffiti )
 {
     is_uniform = false;
-    cosmetics[x][y][COSMETICS_GRAFFITI] = new_graffiti;
+    cosmetics( x, y )[COSMETICS_GRAFFITI] = new_graffiti;
 }
 
 void submap::delete_graffiti( int x, int y )
 {
     is_uniform = false;
-    cosmetics[x][y].erase( COSMETICS_GRAFFITI );
+    if( auto *const c = cosmetics.find( x, y ) ) {
+        c->erase( COSMETICS_GRAFFITI );
+        if( c->empty() ) {
+            cosmetics.erase( x, y );
+        }
+    }
 }
@@ -11,6 +11,7 @@
 #include "string_id.h"
 #include "active_item_cache.h"
 #include "copyable_unique_ptr.h"
+#include "enums.h"
 
 #include <vector>
 #include <list>
@@ -47,6 +48,80 @@ struct spawn_point {
                  mission_id( MIS ), friendly( F ), name( N ) {}
 };
 
+/**
+ * Per tile data that most tiles of a submap don't have (items, fields, ...).
+ * Only tiles with an entry take up memory. Entries live in a node based container,
+ * so references to them stay valid until they are erased.
+ */
+template<typename T>
+class sparse_tile_map
+{
+    public:
+        using container = std::map<uint16_t, T>;
+
+        /** Entry of the tile, created (default constructed) if it does not exist yet. */
+        T &operator()( const int x, const int y ) {
+            return data[index( x, y )];
+        }
+        /** Entry of the tile, or nullptr if it has none. */
+        T *find( const int x, const int y ) {
+            const auto iter = data.find( index( x, y ) );
+            return iter != data.end() ? &iter->second : nullptr;
+        }
+        const T *find( const int x, const int y ) const {
+            const auto iter = data.find( index( x, y ) );
+            return iter != data.end() ? &iter->second : nullptr;
+        }
+        void erase( const int x, const int y ) {
+            data.erase( index( x, y ) );
+        }
+        /** Erases all entries for which @p is_empty returns true. */
+        template<typename F>
+        void erase_if( const F &is_empty ) {
+            for( auto iter = data.begin(); iter != data.end(); ) {
+                if( is_empty( iter->second ) ) {
+                    iter = data.erase( iter );
+                } else {
+                    ++iter;
+                }
+            }
+        }
+        void clear() {
+            data.clear();
+        }
+        size_t size() const {
+            return data.size();
+        }
+        bool empty() const {
+            return data.empty();
+        }
+
+        typename container::iterator begin() {
+            return data.begin();
+        }
+        typename container::iterator end() {
+            return data.end();
+        }
+        typename container::const_iterator begin() const {
+            return data.begin();
+        }
+        typename container::const_iterator end() const {
+            return data.end();
+        }
+
+        /** Tile coordinates of the key of an entry. */
+        static point position( const uint16_t index ) {
+            return point( index / SEEY, index % SEEY );
+        }
+
+    private:
+        static uint16_t index( const int x, const int y ) {
+            return x * SEEY + y;
+        }
+
+        container data;
+};
+
 struct submap {
     trap_id get_trap( const int x, const int y ) const {
         return trp[x][y];
@@ -76,14 +151,83 @@ struct submap {
     }
 
     int get_radiation( const int x, const int y ) const {
-        return rad[x][y];
+        const int *const r = rad.find( x, y );
+        return r != nullptr ? *r : 0;
     }
 
     void set_radiation( const int x, const int y, const int radiation ) {
         is_uniform = false;
-        rad[x][y] = radiation;
+        if( radiation == 0 ) {
+            rad.erase( x, y );
+        } else {
+            rad( x, y ) = radiation;
+        }
     }
 
+    /** Items on the tile, the list is created if the tile has none yet. */
+    std::list<item> &get_items( const int x, const int y ) {
+        return itm( x, y );
+    }
+    const std::list<item> &get_items( const int x, const int y ) const {
+        static const std::list<item> no_items;
+        const auto *const items = itm.find( x, y );
+        return items != nullptr ? *items : no_items;
+    }
+    bool has_items( const int x, const int y ) const {
+        const auto *const items = itm.find( x, y );
+        return items != nullptr && !items->empty();
+    }
+
+    /** Fields on the tile, the field object is created if the tile has none yet. */
+    field &get_field( const int x, const int y ) {
+        return fld( x, y );
+    }
+    const field &get_field( const int x, const int y ) const {
+        static const field no_field;
+        const field *const f = fld.find( x, y );
+        return f != nullptr ? *f : no_field;
+    }
+    /** Removes and returns the fields on the tile, does not change field_count. */
+    field take_field( const int x, const int y ) {
+        field result;
+        if( field *const f = fld.find( x, y ) ) {
+            result = std::move( *f );
+            fld.erase( x, y );
+        }
+        return result;
+    }
+    /** Replaces the fields on the tile, does not change field_count. */
+    void put_field( const int x, const int y, field &&f ) {
+        if( f.fieldCount() > 0 ) {
+            fld( x, y ) = std::move( f );
+        } else {
+            fld.erase( x, y );
+        }
+    }
+
+    std::map<std::string, std::string> take_cosmetics( const int x, const int y ) {
+        std::map<std::string, std::string> result;
+        if( auto *const c = cosmetics.find( x, y ) ) {
+            result.swap( *c );
+            cosmetics.erase( x, y );
+        }
+        return result;
+    }
+    void put_cosmetics( const int x, const int y, std::map<std::string, std::string> &&c ) {
+        if( c.empty() ) {
+            cosmetics.erase( x, y );
+        } else {
+            cosmetics( x, y ) = std::move( c );
+        }
+    }
+
+    /**
+     * Drops the empty entries of the sparse per tile data (they are created on demand by
+     * the non-const accessors). Must not be called while references to them are held,
+     * e.g. by a @ref map_stack.
+     */
+    void compact();
+
     void update_lum_add( item const &i, int const x, int const y ) {
         is_uniform = false;
         if (i.is_emissive() && lum[x][y] < 255) {
@@ -103,7 +247,7 @@ struct submap {
         // Have to scan through all items to be sure removing i will actally lower
         // the count below 255.
         int count = 0;
-        for (auto const &it : itm[x][y]) {
+        for (auto const &it : get_items( x, y )) {
             if (it.is_emissive()) {
                 count++;
             }
@@ -124,7 +268,8 @@ struct submap {
     // Its effect is meant to be cosmetic and atmospheric only.
     bool has_signage( const int x, const int y) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            return cosmetics[x][y].find("SIGNAGE") != cosmetics[x][y].end();
+            const auto *const c = cosmetics.find( x, y );
+            return c != nullptr && c->find("SIGNAGE") != c->end();
         }
 
         return false;
@@ -132,9 +277,11 @@ struct submap {
     // Dependent on furniture + cosmetics.
     const std::string get_signage( const int x, const int y ) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            auto iter = cosmetics[x][y].find("SIGNAGE");
-            if( iter != cosmetics[x][y].end() ) {
-                return iter->second;
+            if( const auto *const c = cosmetics.find( x, y ) ) {
+                auto iter = c->find("SIGNAGE");
+                if( iter != c->end() ) {
+                    return iter->second;
+                }
             }
         }
 
@@ -143,28 +290,37 @@ struct submap {
     // Can be used anytime (prevents code from needing to place sign first.)
     void set_signage( const int x, const int y, std::string s) {
         is_uniform = false;
-        cosmetics[x][y]["SIGNAGE"] = s;
+        cosmetics( x, y )["SIGNAGE"] = s;
     }
     // Can be used anytime (prevents code from needing to place sign first.)
     void delete_signage( const int x, const int y) {
         is_uniform = false;
-        cosmetics[x][y].erase("SIGNAGE");
+        if( auto *const c = cosmetics.find( x, y ) ) {
+            c->erase("SIGNAGE");
+            if( c->empty() ) {
+                cosmetics.erase( x, y );
+            }
+        }
     }
 
     // TODO: make trp private once the horrible hack known as editmap is resolved
     ter_id          ter[SEEX][SEEY];  // Terrain on each square
     furn_id         frn[SEEX][SEEY];  // Furniture on each square
     std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
-    std::list<item> itm[SEEX][SEEY];  // Items on each square
-    field           fld[SEEX][SEEY];  // Field on each square
     trap_id         trp[SEEX][SEEY];  // Trap on each square
-    int             rad[SEEX][SEEY];  // Irradiation of each square
+
+    // Only few squares have any of these, so they are stored sparsely.
+    sparse_tile_map<std::list<item>> itm; // Items on each square
+    sparse_tile_map<field> fld;           // Field on each square
+    sparse_tile_map<int> rad;             // Irradiation of each square
+    sparse_tile_map<std::map<std::string, std::string>> cosmetics; // Textual "visuals" for each square.
 
     // If is_uniform is true, this submap is a solid block of terrain
     // Uniform submaps aren't saved/loaded, because regenerating them is faster
     bool is_uniform;
-
-    std::map<std::string, std::string> cosmetics[SEEX][SEEY]; // Textual "visuals" for each square.
+    // Shared submaps are placed at many locations at once and must not be modified,
+    // see mapbuffer::get_uniform_submap and map::unshare_submap_at.
+    bool is_shared = false;
 
     active_item_cache active_items;
 
@@ -235,17 +391,18 @@ public:
 
     const field &get_field() const
     {
-        return sm->fld[x][y];
+        return static_cast<const submap *>( sm )->get_field( x, y );
     }
 
     field_entry* find_field( const field_id field_to_find )
     {
-        return sm->fld[x][y].findField( field_to_find );
+        field *const f = sm->fld.find( x, y );
+        return f != nullptr ? f->findField( field_to_find ) : nullptr;
     }
 
     bool add_field( const field_id field_to_add, const int new_density, const int new_age )
     {
-        const bool ret = sm->fld[x][y].addField( field_to_add, new_density, new_age );
+        const bool ret = sm->get_field( x, y ).addField( field_to_add, new_density, new_age );
         if( ret ) {
             sm->field_count++;
         }
@@ -281,12 +438,12 @@ public:
     // For map::draw_maptile
     size_t get_item_count() const
     {
-        return sm->itm[x][y].size();
+        return static_cast<const submap *>( sm )->get_items( x, y ).size();
     }
 
     const item &get_uppermost_item() const
     {
-        return sm->itm[x][y].back();
+        return static_cast<const submap *>( sm )->get_items( x, y ).back();
     }
 };
 
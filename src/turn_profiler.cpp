@@ -0,0 +1,271 @@
+#include "turn_profiler.h"
+
+#include "cata_utility.h"
+#include "cursesdef.h"
+#include "input.h"
+#include "json.h"
+#include "messages.h"
+#include "output.h"
+#include "path_info.h"
+#include "translations.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <ostream>
+
+namespace turn_profiler
+{
+
+/** One invocation of a phase, recorded while tracing. */
+struct trace_event {
+    int phase;
+    clock::time_point start;
+    clock::duration duration;
+};
+
+/** Upper limit of recorded trace events, further ones are dropped. */
+static constexpr size_t max_trace_events = 1000000;
+
+static bool profiler_enabled = false;
+static bool profiler_tracing = false;
+static std::vector<phase_stats> all_phases;
+/** Maps (parent index, name) to the index in all_phases. */
+static std::map<std::pair<int, const char *>, int> phase_index;
+/** Indices of the currently running phases, innermost last. */
+static std::vector<int> phase_stack;
+static std::vector<trace_event> trace_events;
+static clock::time_point trace_start = clock::now();
+static unsigned long profiled_turns = 0;
+
+/** Indices of all phases, each directly followed by its children (depth first). */
+static std::vector<int> phases_in_tree_order()
+{
+    std::vector<int> result;
+    std::function<void( int )> add_children = [&]( const int parent ) {
+        for( size_t i = 0; i < all_phases.size(); ++i ) {
+            if( all_phases[i].parent == parent ) {
+                result.push_back( i );
+                add_children( i );
+            }
+        }
+    };
+    add_children( -1 );
+    return result;
+}
+
+static double to_ms( const clock::duration &d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+std::string phase_stats::path() const
+{
+    if( parent < 0 ) {
+        return name;
+    }
+    return all_phases[parent].path() + "/" + name;
+}
+
+double phase_stats::rolling_average_ms() const
+{
+    const size_t turns = std::min<size_t>( profiled_turns, rolling_turns );
+    if( turns == 0 ) {
+        return 0;
+    }
+    return std::accumulate( per_turn_ms.begin(), per_turn_ms.end(), 0.0 ) / turns;
+}
+
+scoped_phase::scoped_phase( const char *const name ) : index( -1 )
+{
+    if( !profiler_enabled ) {
+        return;
+    }
+    const int parent = phase_stack.empty() ? -1 : phase_stack.back();
+    const auto key = std::make_pair( parent, name );
+    const auto iter = phase_index.find( key );
+    if( iter != phase_index.end() ) {
+        index = iter->second;
+    } else {
+        index = all_phases.size();
+        all_phases.emplace_back( name, parent, phase_stack.size() );
+        phase_index.emplace( key, index );
+    }
+    phase_stack.push_back( index );
+    start = clock::now();
+}
+
+scoped_phase::~scoped_phase()
+{
+    if( index < 0 ) {
+        return;
+    }
+    const clock::duration duration = clock::now() - start;
+    // The profiler may have been reset or disabled while the phase was running.
+    if( phase_stack.empty() || phase_stack.back() != index ||
+        static_cast<size_t>( index ) >= all_phases.size() ) {
+        return;
+    }
+    phase_stack.pop_back();
+
+    phase_stats &stats = all_phases[index];
+    const double ms = to_ms( duration );
+    stats.count++;
+    stats.total_ms += ms;
+    stats.current_turn_ms += ms;
+    stats.max_ms = std::max( stats.max_ms, ms );
+    const auto bucket = std::lower_bound( histogram_bounds.begin(), histogram_bounds.end(), ms );
+    stats.histogram[bucket - histogram_bounds.begin()]++;
+
+    if( profiler_tracing && trace_events.size() < max_trace_events ) {
+        trace_events.push_back( trace_event{ index, start, duration } );
+    }
+}
+
+bool enabled()
+{
+    return profiler_enabled;
+}
+
+void set_enabled( const bool enable )
+{
+    profiler_enabled = enable;
+    phase_stack.clear();
+}
+
+bool tracing()
+{
+    return profiler_tracing;
+}
+
+void set_tracing( const bool trace )
+{
+    profiler_tracing = trace;
+}
+
+void end_turn()
+{
+    if( !profiler_enabled ) {
+        return;
+    }
+    const size_t slot = profiled_turns % rolling_turns;
+    for( auto &stats : all_phases ) {
+        stats.per_turn_ms[slot] = stats.current_turn_ms;
+        stats.current_turn_ms = 0;
+    }
+    profiled_turns++;
+}
+
+unsigned long turns()
+{
+    return profiled_turns;
+}
+
+void reset()
+{
+    all_phases.clear();
+    phase_index.clear();
+    phase_stack.clear();
+    trace_events.clear();
+    trace_start = clock::now();
+    profiled_turns = 0;
+}
+
+const std::vector<phase_stats> &phases()
+{
+    return all_phases;
+}
+
+void write_csv( std::ostream &out )
+{
+    out << "phase,count,total_ms,mean_ms,max_ms,rolling_ms_per_turn";
+    for( const double bound : histogram_bounds ) {
+        out << ",le_" << bound << "ms";
+    }
+    out << ",gt_" << histogram_bounds.back() << "ms\n";
+
+    for( const int i : phases_in_tree_order() ) {
+        const phase_stats &stats = all_phases[i];
+        out << stats.path() << ',' << stats.count << ',' << stats.total_ms << ','
+            << ( stats.count > 0 ? stats.total_ms / stats.count : 0.0 ) << ',' << stats.max_ms << ','
+            << stats.rolling_average_ms();
+        for( const auto bucket : stats.histogram ) {
+            out << ',' << bucket;
+        }
+        out << '\n';
+    }
+}
+
+void write_chrome_trace( JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    for( const auto &ev : trace_events ) {
+        jsout.start_object();
+        jsout.member( "name", all_phases[ev.phase].name );
+        jsout.member( "cat", "turn" );
+        // Complete events, timestamps are in microseconds.
+        jsout.member( "ph", "X" );
+        jsout.member( "ts", std::chrono::duration<double, std::micro>( ev.start - trace_start ).count() );
+        jsout.member( "dur", std::chrono::duration<double, std::micro>( ev.duration ).count() );
+        jsout.member( "pid", 0 );
+        jsout.member( "tid", 0 );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+void show_overlay()
+{
+    const int width = FULL_SCREEN_WIDTH;
+    const int height = FULL_SCREEN_HEIGHT;
+    const int offset_x = ( TERMX > width ) ? ( TERMX - width ) / 2 : 0;
+    const int offset_y = ( TERMY > height ) ? ( TERMY - height ) / 2 : 0;
+    WINDOW *w = newwin( height, width, offset_y, offset_x );
+    WINDOW_PTR wptr( w );
+
+    werase( w );
+    draw_border( w, BORDER_COLOR, _( "Turn profile" ) );
+    mvwprintz( w, 1, 2, c_white, _( "%lu turns profiled, %s, tracing %s" ), profiled_turns,
+               profiler_enabled ? _( "enabled" ) : _( "disabled" ),
+               profiler_tracing ? _( "on" ) : _( "off" ) );
+    mvwprintz( w, 2, 2, c_ltgray, "%-38s %9s %9s %9s %9s", _( "phase" ), _( "ms/turn" ), _( "mean ms" ),
+               _( "max ms" ), _( "calls" ) );
+    int line = 3;
+    for( const int i : phases_in_tree_order() ) {
+        if( line >= height - 1 ) {
+            break;
+        }
+        const phase_stats &stats = all_phases[i];
+        const std::string name = std::string( stats.depth * 2, ' ' ) + stats.name;
+        const double rolling = stats.rolling_average_ms();
+        const nc_color col = rolling >= 10.0 ? c_red : rolling >= 1.0 ? c_yellow : c_white;
+        mvwprintz( w, line++, 2, col, "%-38s %9.3f %9.3f %9.3f %9lu", name.c_str(), rolling,
+                   stats.count > 0 ? stats.total_ms / stats.count : 0.0, stats.max_ms, stats.count );
+    }
+    wrefresh( w );
+    inp_mngr.wait_for_any_key();
+}
+
+void export_files()
+{
+    const std::string csv_path = FILENAMES["turn_profile"];
+    const std::string trace_path = FILENAMES["turn_trace"];
+    const bool csv_ok = write_to_file( csv_path, []( std::ostream & fout ) {
+        write_csv( fout );
+    }, _( "turn profile" ) );
+    const bool trace_ok = write_to_file( trace_path, []( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        write_chrome_trace( jsout );
+    }, _( "turn trace" ) );
+    if( csv_ok && trace_ok ) {
+        add_msg( m_info, _( "Turn profile written to %s and %s." ), csv_path.c_str(),
+                 trace_path.c_str() );
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef TURN_PROFILER_H
+#define TURN_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class JsonOut;
+
+/**
+ * Instrumentation of the phases of a game turn (see game::do_turn).
+ *
+ * Phases are marked with @ref turn_profiler::scoped_phase objects, which may be nested.
+ * While the profiler is disabled (the default) a phase costs one branch. When enabled,
+ * each phase accumulates call counts, total and maximal time and a histogram of its
+ * durations, and every turn the time spent per phase is recorded for the overlay.
+ * Optionally the individual phase invocations are recorded as a trace that can be
+ * exported in the Chrome trace event format (load it in chrome://tracing).
+ */
+namespace turn_profiler
+{
+
+using clock = std::chrono::steady_clock;
+
+/** Upper bounds (in milliseconds) of the histogram buckets, the last bucket is open. */
+constexpr std::array<double, 7> histogram_bounds = {{ 0.1, 0.5, 1.0, 5.0, 10.0, 50.0, 100.0 }};
+/** Number of past turns kept for the rolling per turn numbers. */
+constexpr size_t rolling_turns = 100;
+
+struct phase_stats {
+    /** Name as given to the @ref scoped_phase. */
+    const char *name;
+    /** Index of the enclosing phase in @ref phases(), or -1 for top level phases. */
+    int parent;
+    int depth;
+    unsigned long count = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+    std::array<unsigned long, histogram_bounds.size() + 1> histogram = {{}};
+    /** Time spent in this phase during each of the last turns, see @ref rolling_turns. */
+    std::array<double, rolling_turns> per_turn_ms = {{}};
+    /** Time spent in this phase during the current turn. */
+    double current_turn_ms = 0;
+
+    phase_stats( const char *name, int parent, int depth ) : name( name ), parent( parent ),
+        depth( depth ) { }
+
+    /** "parent/child" path of the phase. */
+    std::string path() const;
+    /** Average time per turn over the last turns recorded. */
+    double rolling_average_ms() const;
+};
+
+/**
+ * Times the enclosing scope as a phase named @p name. The name must be a string literal
+ * (or otherwise outlive the profiler), phases are identified by the pointer.
+ */
+class scoped_phase
+{
+    public:
+        scoped_phase( const char *name );
+        ~scoped_phase();
+
+        scoped_phase( const scoped_phase & ) = delete;
+        scoped_phase &operator=( const scoped_phase & ) = delete;
+    private:
+        int index;
+        clock::time_point start;
+};
+
+bool enabled();
+void set_enabled( bool enable );
+/** Whether individual phase invocations are recorded for @ref write_chrome_trace. */
+bool tracing();
+void set_tracing( bool trace );
+
+/** Completes the current turn: rolls the per turn times over. */
+void end_turn();
+/** Number of turns profiled since the last @ref reset. */
+unsigned long turns();
+/** Forget all collected data. */
+void reset();
+
+/** All phases seen so far, in order of their first invocation. */
+const std::vector<phase_stats> &phases();
+
+/** Writes one line per phase with its statistics. */
+void write_csv( std::ostream &out );
+/** Writes the recorded trace in the Chrome trace event format. */
+void write_chrome_trace( JsonOut &jsout );
+
+/** Shows the rolling per phase times in a window, until a key is pressed. */
+void show_overlay();
+/** Writes the CSV and the trace to the config directory, reporting the result via messages. */
+void export_files();
+
+}
+
+#endif
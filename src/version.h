@@ -1 +1 @@
-#define VERSION "0.C-6457-5337fb8f50"
+#define VERSION "95de301-dirty"
@@ -142,9 +142,15 @@ bool visitable<T>::has_quality( const quality_id &qual, int level, int qty ) con
 template <>
 bool visitable<inventory>::has_quality( const quality_id &qual, int level, int qty ) const
 {
+    const auto &binned = static_cast<const inventory *>( this )->get_binned_qualities();
+    const auto iter = binned.find( qual );
+    if( iter == binned.end() ) {
+        return false;
+    }
+
     int res = 0;
-    for( const auto &stack : static_cast<const inventory *>( this )->items ) {
-        res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
+    for( auto lvl = iter->second.lower_bound( level ); lvl != iter->second.end(); ++lvl ) {
+        res = sum_no_wrap( res, lvl->second );
         if( res >= qty ) {
             return true;
         }
@@ -232,6 +238,15 @@ int visitable<T>::max_quality( const quality_id &qual ) const
     return max_quality_internal( *this, qual );
 }
 
+/** @relates visitable */
+template<>
+int visitable<inventory>::max_quality( const quality_id &qual ) const
+{
+    const auto &binned = static_cast<const inventory *>( this )->get_binned_qualities();
+    const auto iter = binned.find( qual );
+    return iter != binned.end() ? iter->second.rbegin()->first : INT_MIN;
+}
+
 /** @relates visitable */
 template<>
 int visitable<Character>::max_quality( const quality_id &qual ) const
@@ -631,7 +646,7 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
     int x, y;
     submap *sub = g->m.get_submap_at( *cur, x, y );
 
-    for( auto iter = sub->itm[ x ][ y ].begin(); iter != sub->itm[ x ][ y ].end(); ) {
+    for( auto iter = sub->get_items( x, y ).begin(); iter != sub->get_items( x, y ).end(); ) {
         if( filter( *iter ) ) {
             // check for presence in the active items cache
             if( sub->active_items.has( iter, point( x, y ) ) ) {
@@ -642,7 +657,7 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
             sub->update_lum_rem( *iter, x, y );
 
             // finally remove the item
-            res.splice( res.end(), sub->itm[ x ][ y ], iter++ );
+            res.splice( res.end(), sub->get_items( x, y ), iter++ );
 
             if( --count == 0 ) {
                 return res;
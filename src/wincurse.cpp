@@ -8,6 +8,7 @@
 #include "color.h"
 #include "catacharset.h"
 #include "get_version.h"
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -331,11 +332,13 @@ void curses_drawwindow(WINDOW *win)
                 update.top = update.bottom - fontheight;
             }
 
-            win->line[j].touched=false;
+            const int last = std::min( win->width, win->line[j].dirty_end );
+            i = std::max( 0, win->line[j].dirty_begin );
+            win->line[j].untouch();
 
-            for (i=0; i<win->width; i++){
+            for (; i<last; i++){
                 const cursecell &cell = win->line[j].chars[i];
-                if( cell.ch.empty() ) {
+                if( cell.empty() ) {
                     continue; // second cell of a multi-cell character
                 }
                 drawx=((win->x+i)*fontwidth);
@@ -348,14 +351,14 @@ void curses_drawwindow(WINDOW *win)
                 int FG = cell.FG;
                 int BG = cell.BG;
                 FillRectDIB(drawx,drawy,fontwidth,fontheight,BG);
-                static const std::string space_string = " ";
                 // Spaces don't need any drawing except background
-                if( cell.ch == space_string ) {
+                if( cell.glyph == ' ' ) {
                     continue;
                 }
 
-                const char* utf8str = cell.ch.c_str();
-                int len = cell.ch.length();
+                const std::string &ch = cell.ch();
+                const char* utf8str = ch.c_str();
+                int len = ch.length();
 
                 tmp = UTF8_getch(&utf8str, &len);
                 if (tmp != UNKNOWN_UNICODE) {
@@ -369,11 +372,11 @@ void curses_drawwindow(WINDOW *win)
                         i += cw - 1;
                     }
                     if (tmp) {
-                        const std::wstring utf16 = widen(cell.ch);
+                        const std::wstring utf16 = widen(ch);
                         ExtTextOutW( backbuffer, drawx, drawy, 0, NULL, utf16.c_str(), utf16.length(), NULL );
                     }
                 } else {
-                    switch ((unsigned char)win->line[j].chars[i].ch[0]) {
+                    switch ((unsigned char)ch[0]) {
                     case LINE_OXOX_C://box bottom/top side (horizontal line)
                         HorzLineDIB(drawx,drawy+halfheight,drawx+fontwidth,1,FG);
                         break;
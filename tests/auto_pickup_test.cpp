@@ -0,0 +1,81 @@
+#include "catch/catch.hpp"
+
+#include "auto_pickup.h"
+#include "options.h"
+#include "output.h"
+
+#include <sstream>
+
+static void load_rules( auto_pickup &rules, const std::string &json )
+{
+    std::istringstream buffer( json );
+    JsonIn jsin( buffer );
+    rules.deserialize( jsin );
+}
+
+TEST_CASE( "wildcard_patterns" ) {
+    CHECK( wildcard_match( "Plastic Bottle", "plastic bottle" ) );
+    CHECK_FALSE( wildcard_match( "plastic bottles", "plastic bottle" ) );
+    CHECK( wildcard_match( "plastic bottle", "plastic*" ) );
+    CHECK( wildcard_match( "plastic bottle", "*BOTTLE" ) );
+    CHECK( wildcard_match( "plastic bottle", "*stic*" ) );
+    CHECK( wildcard_match( "plastic bottle", "p**c*b*e" ) );
+    CHECK_FALSE( wildcard_match( "plastic bottle", "*glass*" ) );
+    CHECK_FALSE( wildcard_match( "plastic bottle", "bottle*" ) );
+    // The suffix must not overlap the prefix.
+    CHECK_FALSE( wildcard_match( "aba", "ab*ba" ) );
+    CHECK_FALSE( wildcard_match( "", "*" ) );
+    CHECK( wildcard_match( "*", "anything" ) );
+
+    const wildcard_pattern pattern( "*can*" );
+    CHECK( pattern.matches( "tin can" ) );
+    CHECK( pattern.matches( "Canteen" ) );
+    CHECK_FALSE( pattern.matches( "bottle" ) );
+}
+
+TEST_CASE( "auto_pickup_rules" ) {
+    get_options().get_option( "AUTO_PICKUP" ).setValue( "true" );
+
+    auto_pickup rules;
+    load_rules( rules, R"([
+        { "rule": "*bottle*", "active": true, "exclude": false },
+        { "rule": "glass bottle", "active": true, "exclude": true },
+        { "rule": "*can*", "active": false, "exclude": false },
+        { "rule": "*", "active": true, "exclude": true },
+        { "rule": "*jerky*", "active": true, "exclude": false }
+    ])" );
+
+    SECTION( "the last matching rule decides" ) {
+        CHECK( rules.check_item( "plastic bottle" ) == RULE_BLACKLISTED );
+        CHECK( rules.check_item( "jerky" ) == RULE_WHITELISTED );
+        CHECK( rules.check_item( "tin can" ) == RULE_BLACKLISTED );
+    }
+    SECTION( "inactive and missing rules do not match" ) {
+        auto_pickup empty_rules;
+        CHECK( empty_rules.check_item( "tin can" ) == RULE_NONE );
+        load_rules( empty_rules, R"([ { "rule": "*can*", "active": false, "exclude": false } ])" );
+        CHECK( empty_rules.check_item( "tin can" ) == RULE_NONE );
+    }
+    SECTION( "added rules apply to names checked before" ) {
+        CHECK( rules.check_item( "tin can" ) == RULE_BLACKLISTED );
+        CHECK( rules.check_item( "glass bottle" ) == RULE_BLACKLISTED );
+        rules.add_rule( "tin can" );
+        CHECK( rules.check_item( "tin can" ) == RULE_WHITELISTED );
+        CHECK( rules.check_item( "glass bottle" ) == RULE_BLACKLISTED );
+
+        rules.remove_rule( "TIN CAN" );
+        CHECK( rules.check_item( "tin can" ) == RULE_BLACKLISTED );
+    }
+    SECTION( "removing a rule reveals the rules before it" ) {
+        auto_pickup own_rules;
+        own_rules.add_rule( "*can*" );
+        own_rules.add_rule( "tin can" );
+        CHECK( own_rules.check_item( "tin can" ) == RULE_WHITELISTED );
+        CHECK( own_rules.check_item( "canteen" ) == RULE_WHITELISTED );
+        own_rules.remove_rule( "*can*" );
+        CHECK( own_rules.check_item( "tin can" ) == RULE_WHITELISTED );
+        CHECK( own_rules.check_item( "canteen" ) == RULE_NONE );
+        own_rules.clear_character_rules();
+        CHECK( own_rules.check_item( "tin can" ) == RULE_NONE );
+    }
+}
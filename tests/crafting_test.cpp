@@ -210,3 +210,92 @@ TEST_CASE( "available_recipes", "[.]" ) {
         }
     }
 }
+
+TEST_CASE( "crafting_inventory_qualities" ) {
+    const quality_id HAMMER( "HAMMER" );
+    const quality_id SCREW( "SCREW" );
+    const quality_id BUTCHER( "BUTCHER" );
+    const quality_id SAW_M( "SAW_M" );
+
+    inventory crafting_inv;
+    crafting_inv.add_item( item( "hammer" ) );
+    crafting_inv.add_item( item( "hammer" ) );
+    item backpack( "backpack" );
+    backpack.put_in( item( "screwdriver" ) );
+    crafting_inv.add_item( backpack );
+
+    GIVEN( "two hammers and a screwdriver in a backpack" ) {
+        THEN( "the qualities are counted like in the items" ) {
+            CHECK( crafting_inv.has_quality( HAMMER, 3, 2 ) );
+            CHECK_FALSE( crafting_inv.has_quality( HAMMER, 3, 3 ) );
+            CHECK_FALSE( crafting_inv.has_quality( HAMMER, 4 ) );
+            CHECK( crafting_inv.has_quality( SCREW ) );
+            CHECK_FALSE( crafting_inv.has_quality( SAW_M ) );
+            CHECK( crafting_inv.max_quality( HAMMER ) == 3 );
+            CHECK( crafting_inv.max_quality( SAW_M ) == INT_MIN );
+        }
+
+        WHEN( "a toolbox is added" ) {
+            crafting_inv.add_item( item( "toolbox" ) );
+
+            THEN( "its qualities are found too" ) {
+                CHECK( crafting_inv.has_quality( HAMMER, 3, 3 ) );
+                CHECK( crafting_inv.has_quality( SAW_M, 2 ) );
+                CHECK( crafting_inv.max_quality( BUTCHER ) == 12 );
+            }
+        }
+
+        WHEN( "the backpack is removed" ) {
+            crafting_inv.remove_item( &crafting_inv.find_item( crafting_inv.position_by_type( "backpack" ) ) );
+
+            THEN( "the screwdriver is gone" ) {
+                CHECK_FALSE( crafting_inv.has_quality( SCREW ) );
+                CHECK( crafting_inv.max_quality( SCREW ) == INT_MIN );
+            }
+        }
+    }
+}
+
+TEST_CASE( "recipe_subset_search" ) {
+    const recipe *rum = &recipe_dict[ "brew_rum" ];
+    const recipe *mead = &recipe_dict[ "brew_mead" ];
+    recipe_subset subset;
+    subset.include( rum );
+    subset.include( mead );
+
+    const auto search = [&subset]( const std::string &txt,
+    const recipe_subset::search_type key = recipe_subset::search_type::name ) {
+        const auto res = subset.search( txt, key );
+        return std::set<const recipe *>( res.begin(), res.end() );
+    };
+
+    GIVEN( "the recipes of rum and mead" ) {
+        THEN( "they are found by parts of their names in any case" ) {
+            CHECK( search( "w" ) == std::set<const recipe *>( { rum } ) );
+            CHECK( search( "WoRt" ) == std::set<const recipe *>( { rum } ) );
+            CHECK( search( "mead must" ) == std::set<const recipe *>( { mead } ) );
+            CHECK( search( "u" ) == std::set<const recipe *>( { rum, mead } ) );
+            CHECK( search( "beer" ).empty() );
+        }
+
+        THEN( "they are found by their components" ) {
+            CHECK( search( "molasses", recipe_subset::search_type::component ) ==
+                   std::set<const recipe *>( { rum } ) );
+            CHECK( search( "yeast", recipe_subset::search_type::component ) ==
+                   std::set<const recipe *>( { rum, mead } ) );
+        }
+
+        WHEN( "a query is narrowed down" ) {
+            REQUIRE( search( "s" ).size() == 1 );
+
+            AND_WHEN( "a matching recipe is included in between" ) {
+                const recipe *moonshine = &recipe_dict[ "brew_moonshine" ];
+                subset.include( moonshine );
+
+                THEN( "the narrower query still finds it" ) {
+                    CHECK( search( "sh" ) == std::set<const recipe *>( { moonshine } ) );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "catch/catch.hpp"
+
+#include "item.h"
+#include "item_search.h"
+
+TEST_CASE( "item_filters" ) {
+    const item hammer( "hammer" );
+    const item bottle( "bottle_plastic" );
+
+    const auto matches = []( const std::string & filter, const item & it ) {
+        return item_filter_from_string( filter )( it );
+    };
+
+    SECTION( "by name" ) {
+        CHECK( matches( "", hammer ) );
+        CHECK( matches( "HAM", hammer ) );
+        CHECK_FALSE( matches( "bottle", hammer ) );
+        CHECK( matches( "{bottle}", bottle ) );
+    }
+    SECTION( "by category and material" ) {
+        CHECK( matches( "c:tool", hammer ) );
+        CHECK_FALSE( matches( "c:tool", bottle ) );
+        CHECK( matches( "m:wood", hammer ) );
+        CHECK( matches( "m:PLAST", bottle ) );
+        CHECK_FALSE( matches( "m:plast", hammer ) );
+    }
+    SECTION( "combined filters" ) {
+        CHECK( matches( "-bottle", hammer ) );
+        CHECK_FALSE( matches( "-m:steel", hammer ) );
+        CHECK( matches( "b:m:steel ;c:tools", hammer ) );
+        CHECK_FALSE( matches( "b:m:steel ;c:other", hammer ) );
+        CHECK( matches( "bottle,hammer", hammer ) );
+        CHECK( matches( "bottle,hammer", bottle ) );
+        CHECK_FALSE( matches( "bottle,hammer,-m:wood", hammer ) );
+    }
+    SECTION( "a filter can be reused" ) {
+        const auto filter = item_filter_from_string( "m:steel" );
+        for( int i = 0; i < 3; i++ ) {
+            CHECK( filter( hammer ) );
+            CHECK_FALSE( filter( bottle ) );
+        }
+    }
+}
@@ -2,7 +2,12 @@
 
 #include "game.h"
 #include "map.h"
+#include "map_iterator.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "mapgen_writer.h"
 #include "player.h"
+#include "submap.h"
 
 TEST_CASE( "destroy_grabbed_furniture" ) {
     GIVEN( "Furniture grabbed by the player" ) {
@@ -21,3 +26,137 @@ TEST_CASE( "destroy_grabbed_furniture" ) {
         }
     }
 }
+
+TEST_CASE( "sees_follows_transparency_changes" ) {
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 66, 60, 0 );
+    const tripoint between( 63, 60, 0 );
+    for( const tripoint &p : g->m.points_in_rectangle( from, to ) ) {
+        g->m.furn_set( p, furn_id( "f_null" ) );
+        g->m.ter_set( p, ter_id( "t_floor" ) );
+    }
+    g->m.build_map_cache( 0, true );
+    REQUIRE( g->m.sees( from, to, 10 ) );
+    // Asked again, answered from the cache.
+    REQUIRE( g->m.sees( from, to, 10 ) );
+    CHECK_FALSE( g->m.sees( from, to, 5 ) );
+
+    g->m.ter_set( between, ter_id( "t_wall" ) );
+    g->m.build_map_cache( 0, true );
+    CHECK_FALSE( g->m.sees( from, to, 10 ) );
+
+    g->m.ter_set( between, ter_id( "t_floor" ) );
+    g->m.build_map_cache( 0, true );
+    CHECK( g->m.sees( from, to, 10 ) );
+}
+
+TEST_CASE( "submap_sparse_storage" ) {
+    submap sm;
+    CHECK( sm.get_radiation( 3, 4 ) == 0 );
+    sm.set_radiation( 3, 4, 25 );
+    CHECK( sm.get_radiation( 3, 4 ) == 25 );
+    CHECK( sm.rad.size() == 1 );
+    sm.set_radiation( 3, 4, 0 );
+    CHECK( sm.rad.empty() );
+
+    const submap &const_sm = sm;
+    CHECK( const_sm.get_items( 1, 2 ).empty() );
+    CHECK( const_sm.get_field( 1, 2 ).fieldCount() == 0 );
+    CHECK( sm.itm.empty() );
+    CHECK( sm.fld.empty() );
+
+    sm.get_items( 1, 2 ).push_back( item( "rock" ) );
+    sm.get_items( 5, 6 );
+    sm.get_field( 7, 8 ).addField( fd_blood, 1, 0 );
+    sm.get_field( 9, 10 );
+    CHECK( sm.has_items( 1, 2 ) );
+    CHECK_FALSE( sm.has_items( 5, 6 ) );
+
+    sm.compact();
+    CHECK( sm.itm.size() == 1 );
+    CHECK( sm.fld.size() == 1 );
+    CHECK( const_sm.get_items( 1, 2 ).size() == 1 );
+    CHECK( const_sm.get_field( 7, 8 ).findField( fd_blood ) != nullptr );
+}
+
+TEST_CASE( "shared_uniform_submaps_are_copied_on_write" ) {
+    const ter_id rock( "t_rock" );
+    const ter_id floor( "t_rock_floor" );
+    submap *const shared = MAPBUFFER.get_uniform_submap( rock );
+    REQUIRE( shared->is_shared );
+    CHECK( MAPBUFFER.get_uniform_submap( rock ) == shared );
+
+    // A quad far away from everything else the tests load.
+    const tripoint origin( -1000, -1000, 0 );
+    for( int x = 0; x < 2; x++ ) {
+        for( int y = 0; y < 2; y++ ) {
+            MAPBUFFER.add_submap( origin + tripoint( x, y, 0 ), shared );
+        }
+    }
+    tinymap tm;
+    tm.load( origin.x, origin.y, origin.z, false );
+    CHECK( tm.ter( tripoint( 1, 1, origin.z ) ) == rock );
+
+    tm.ter_set( tripoint( 1, 1, origin.z ), floor );
+    CHECK( tm.ter( tripoint( 1, 1, origin.z ) ) == floor );
+    submap *const changed = MAPBUFFER.lookup_submap( origin );
+    CHECK( changed != shared );
+    CHECK_FALSE( changed->is_shared );
+    CHECK( changed->get_ter( 1, 1 ) == floor );
+    CHECK( shared->get_ter( 1, 1 ) == rock );
+    CHECK( MAPBUFFER.lookup_submap( origin + tripoint( 1, 0, 0 ) ) == shared );
+}
+
+TEST_CASE( "mapgen_writer_rotation_matches_map_rotate" ) {
+    const std::vector<ter_id> pattern = {{
+            ter_id( "t_rock_floor" ), ter_id( "t_fence_h" ), ter_id( "t_wall" ), ter_id( "t_dirt" )
+        }
+    };
+    const furn_id chair( "f_chair" );
+    submap *const shared = MAPBUFFER.get_uniform_submap( ter_id( "t_rock" ) );
+    const auto draw = [&]( mapgen_writer & w ) {
+        for( int x = 0; x < SEEX * 2; x++ ) {
+            for( int y = 0; y < SEEY * 2; y++ ) {
+                w.ter_set( x, y, pattern[( x * 7 + y * 3 ) % pattern.size()] );
+                if( x == y + 3 ) {
+                    w.furn_set( x, y, chair );
+                }
+            }
+        }
+    };
+
+    for( int turns = 0; turns < 4; turns++ ) {
+        // Quads far away from everything else the tests load.
+        const tripoint written_rotated( -1100 + turns * 4, -1100, 0 );
+        const tripoint rotated_after( -1100 + turns * 4, -1096, 0 );
+        for( int x = 0; x < 2; x++ ) {
+            for( int y = 0; y < 2; y++ ) {
+                MAPBUFFER.add_submap( written_rotated + tripoint( x, y, 0 ), shared );
+                MAPBUFFER.add_submap( rotated_after + tripoint( x, y, 0 ), shared );
+            }
+        }
+        tinymap expected;
+        expected.load( rotated_after.x, rotated_after.y, 0, false );
+        mapgen_writer unrotated( expected );
+        draw( unrotated );
+        expected.rotate( turns );
+
+        tinymap actual;
+        actual.load( written_rotated.x, written_rotated.y, 0, false );
+        mapgen_writer rotated( actual, turns );
+        draw( rotated );
+
+        for( int x = 0; x < SEEX * 2; x++ ) {
+            for( int y = 0; y < SEEY * 2; y++ ) {
+                CAPTURE( turns );
+                CAPTURE( x );
+                CAPTURE( y );
+                CHECK( actual.ter( x, y ) == expected.ter( x, y ) );
+                CHECK( actual.furn( x, y ) == expected.furn( x, y ) );
+            }
+        }
+        // Reading back through the writer undoes the rotation.
+        CHECK( rotated.ter( 3, 0 ) == pattern[1] );
+        CHECK( rotated.furn( 3, 0 ) == chair );
+    }
+}
@@ -1,6 +1,7 @@
 #include "catch/catch.hpp"
 
 #include "common_types.h"
+#include "creature_tracker.h"
 #include "player.h"
 #include "npc.h"
 #include "npc_class.h"
@@ -178,3 +179,56 @@ TEST_CASE("snippet-tag-test")
     CHECK( SNIPPET.all_ids_from_category( "<mywp>" ).empty() );
     CHECK( SNIPPET.all_ids_from_category( "<ammo>" ).empty() );
 }
+
+/** Moves @p who the way the game does for an active NPC. */
+static void move_tracked( Creature_tracker &tracker, npc &who, const tripoint &dest )
+{
+    tracker.update_npc_pos( who, dest );
+    who.setpos( dest );
+}
+
+TEST_CASE( "npc_lookup_by_location" )
+{
+    npc first = create_model();
+    npc second = create_model();
+    // Keeps setpos from moving them between overmaps, they are on none.
+    first.set_fake( true );
+    second.set_fake( true );
+    const tripoint first_pos( 10, 10, 0 );
+    const tripoint second_pos( 11, 10, 0 );
+    first.setpos( first_pos );
+    second.setpos( second_pos );
+
+    Creature_tracker tracker;
+    tracker.rebuild_npc_cache( { &first, &second } );
+    CHECK( tracker.npc_at( first_pos ) == &first );
+    CHECK( tracker.npc_at( second_pos ) == &second );
+    CHECK( tracker.npc_at( tripoint( 12, 10, 0 ) ) == nullptr );
+    CHECK( tracker.npc_at( tripoint( 10, 10, 1 ) ) == nullptr );
+
+    SECTION( "moving leaves the old position empty" ) {
+        const tripoint dest( 12, 12, -1 );
+        move_tracked( tracker, first, dest );
+        CHECK( tracker.npc_at( first_pos ) == nullptr );
+        CHECK( tracker.npc_at( dest ) == &first );
+    }
+    SECTION( "swapping places" ) {
+        move_tracked( tracker, first, second_pos );
+        move_tracked( tracker, second, first_pos );
+        CHECK( tracker.npc_at( first_pos ) == &second );
+        CHECK( tracker.npc_at( second_pos ) == &first );
+    }
+    SECTION( "outside of the reality bubble" ) {
+        const tripoint dest( -5, 10, 0 );
+        move_tracked( tracker, first, dest );
+        CHECK( tracker.npc_at( dest ) == &first );
+        move_tracked( tracker, first, first_pos );
+        CHECK( tracker.npc_at( dest ) == nullptr );
+        CHECK( tracker.npc_at( first_pos ) == &first );
+    }
+    SECTION( "untracked NPCs are not found" ) {
+        tracker.rebuild_npc_cache( { &second } );
+        CHECK( tracker.npc_at( first_pos ) == nullptr );
+        CHECK( tracker.npc_at( second_pos ) == &second );
+    }
+}
@@ -2,6 +2,8 @@
 
 #include "overmap.h"
 
+#include <sstream>
+
 TEST_CASE( "set_and_get_overmap_scents" ) {
     overmap test_overmap;
 
@@ -19,3 +21,51 @@ TEST_CASE( "set_and_get_overmap_scents" ) {
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).creation_turn == 50 );
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
+
+TEST_CASE( "overmap_terrain_and_view_survive_saving" ) {
+    overmap saved;
+    const oter_id road( "road_ns" );
+    const oter_id house( "house_north" );
+    for( int x = 0; x < OMAPX; ++x ) {
+        saved.ter( x, 20, 0 ) = road;
+        saved.seen( x, 20, 0 ) = true;
+    }
+    saved.ter( 5, 7, -2 ) = house;
+    saved.explored( 5, 7, -2 ) = true;
+    for( int x = 0; x < OMAPX; ++x ) {
+        for( int y = 0; y < OMAPY; ++y ) {
+            saved.seen( x, y, 3 ) = true;
+        }
+    }
+
+    std::ostringstream terrain_out;
+    std::ostringstream view_out;
+    saved.serialize( terrain_out );
+    saved.serialize_view( view_out );
+
+    overmap loaded;
+    std::istringstream terrain_in( terrain_out.str() );
+    std::istringstream view_in( view_out.str() );
+    loaded.unserialize( terrain_in );
+    loaded.unserialize_view( view_in );
+
+    SECTION( "untouched layers are saved as they were loaded" ) {
+        std::ostringstream resaved;
+        loaded.serialize( resaved );
+        CHECK( resaved.str() == terrain_out.str() );
+    }
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                if( loaded.get_ter( x, y, z ) != saved.get_ter( x, y, z ) ||
+                    loaded.seen( x, y, z ) != saved.seen( x, y, z ) ||
+                    loaded.explored( x, y, z ) != saved.explored( x, y, z ) ) {
+                    FAIL( "mismatch at " << x << "," << y << "," << z );
+                }
+            }
+        }
+    }
+    CHECK( loaded.get_ter( 10, 20, 0 ) == road );
+    CHECK( loaded.get_ter( 5, 7, -2 ) == house );
+}
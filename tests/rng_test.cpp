@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+
+#include "rng.h"
+
+#include <vector>
+
+TEST_CASE( "rng_engine_is_reproducible", "[rng]" ) {
+    rng_engine a( 1234 );
+    rng_engine b( 1234 );
+    rng_engine c( 4321 );
+    bool differs = false;
+    for( int i = 0; i < 100; ++i ) {
+        const auto va = a();
+        REQUIRE( va == b() );
+        differs |= va != c();
+    }
+    CHECK( differs );
+}
+
+TEST_CASE( "rng_engine_serialization", "[rng]" ) {
+    rng_engine a( 99 );
+    for( int i = 0; i < 10; ++i ) {
+        a();
+    }
+    rng_engine b;
+    REQUIRE( b.deserialize( a.serialize() ) );
+    CHECK( a == b );
+    CHECK( a() == b() );
+    CHECK_FALSE( b.deserialize( "not a state" ) );
+}
+
+TEST_CASE( "rng_stays_in_range", "[rng]" ) {
+    rng_set_seed( 7 );
+    std::vector<int> hits( 7, 0 );
+    for( int i = 0; i < 7000; ++i ) {
+        const long val = rng( 3, -3 );
+        REQUIRE( val >= -3 );
+        REQUIRE( val <= 3 );
+        hits[val + 3]++;
+    }
+    for( const int h : hits ) {
+        CHECK( h > 800 );
+        CHECK( h < 1200 );
+    }
+    for( int i = 0; i < 1000; ++i ) {
+        const double val = rng_float( 0.5, 1.5 );
+        REQUIRE( val >= 0.5 );
+        REQUIRE( val < 1.5 );
+    }
+    CHECK( x_in_y( 1, 1 ) );
+    CHECK_FALSE( x_in_y( 0, 1 ) );
+}
+
+TEST_CASE( "rng_streams_are_independent", "[rng]" ) {
+    rng_set_seed( 42 );
+    const long first = rng( 0, 1000000 );
+
+    rng_set_seed( 42 );
+    {
+        // Draws from another stream must not affect the general one.
+        rng_stream_scope scope( rng_stream::combat );
+        for( int i = 0; i < 10; ++i ) {
+            rng( 0, 1000000 );
+        }
+    }
+    CHECK( rng( 0, 1000000 ) == first );
+
+    rng_engine local( rng_derive_seed( 42, 1, 2, 0 ) );
+    rng_engine same( rng_derive_seed( 42, 1, 2, 0 ) );
+    rng_engine other( rng_derive_seed( 42, 2, 1, 0 ) );
+    CHECK( local == same );
+    CHECK_FALSE( local == other );
+}
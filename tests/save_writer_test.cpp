@@ -0,0 +1,45 @@
+#include "catch/catch.hpp"
+
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "save_writer.h"
+
+#include <sstream>
+
+static std::string read_content( const std::string &path )
+{
+    std::string content;
+    read_from_file( path, [&content]( std::istream & fin ) {
+        std::ostringstream buffer;
+        buffer << fin.rdbuf();
+        content = buffer.str();
+    } );
+    return content;
+}
+
+TEST_CASE( "save_writer_writes_files" ) {
+    const std::string prefix = "save_writer_test.";
+    std::vector<std::string> paths;
+    for( int i = 0; i < 20; i++ ) {
+        paths.push_back( prefix + std::to_string( i ) );
+        save_writer::write( paths.back(), std::string( 1000 * i, 'a' + i ) );
+    }
+
+    SECTION( "reading a file waits for its write" ) {
+        CHECK( read_content( paths[19] ) == std::string( 19000, 'a' + 19 ) );
+    }
+    SECTION( "the last write of a file wins" ) {
+        const std::string path = prefix + "last";
+        save_writer::write( path, "first" );
+        save_writer::write( path, "second" );
+        CHECK( read_content( path ) == "second" );
+        remove_file( path );
+    }
+
+    REQUIRE( save_writer::wait() );
+    for( size_t i = 0; i < paths.size(); i++ ) {
+        CHECK_FALSE( file_exist( paths[i] + ".temp" ) );
+        CHECK( read_content( paths[i] ).size() == 1000 * i );
+        remove_file( paths[i] );
+    }
+}
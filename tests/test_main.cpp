@@ -8,6 +8,7 @@
 #include "morale.h"
 #include "path_info.h"
 #include "player.h"
+#include "rng.h"
 #include "worldfactory.h"
 #include "debug.h"
 #include "mod_manager.h"
@@ -137,6 +138,8 @@ int main( int argc, const char *argv[] )
     }
 
     test_mode = true;
+    // Deterministic unless a seed is requested with --rng-seed.
+    rng_set_seed( session.configData().rngSeed );
 
     try {
         // TODO: Only init game if we're running tests that need it.